@@ -7,6 +7,8 @@
  **********************************************************************************************************************/
 
 #include "button.h"
+#include "glyphs.h"
+#include "perf.h"
 
 
 static unsigned char clampc(float v) {
@@ -25,25 +27,38 @@ Color btn_shade(Color color, float f) {
 }
 
 
-bool btn_draw(Button *button) {
-    Vector2 mp = GetMousePosition();
-    bool hovered = CheckCollisionPointRec(mp, button->bounds);
-    bool pressed = hovered && IsMouseButtonDown(MOUSE_LEFT_BUTTON);
-    bool clicked = hovered && IsMouseButtonReleased(MOUSE_LEFT_BUTTON);
+void btn_measure(Button *button) {
+    button->labelWidth = glyphs_measure(button->label, GLYPH_LABEL_SIZE);
+}
+
+
+BtnState btn_state(const Button *button, Vector2 mouse, bool mouseDown) {
+    if(!CheckCollisionPointRec(mouse, button->bounds)) return BTN_IDLE;
+    return mouseDown ? BTN_PRESSED : BTN_HOVER;
+}
 
+
+void btn_render(const Button *button, BtnState state) {
     Color bg = button->baseColor;
-    if(hovered) bg = btn_shade(bg, 1.15f);
-    if(pressed) bg = btn_shade(bg, 0.80f);
+    if(state != BTN_IDLE)    bg = btn_shade(bg, 1.15f);
+    if(state == BTN_PRESSED) bg = btn_shade(bg, 0.80f);
 
     Color border = btn_shade(button->baseColor, 0.65f);
     DrawRectangleRec(button->bounds, bg);
     DrawRectangleLinesEx(button->bounds, 2, border);
 
-    int fontSize = 40;
-    int tw = MeasureText(button->label, fontSize);
-    DrawText(button->label,
-             button->bounds.x + (button->bounds.width - tw) / 2,
-             button->bounds.y + (button->bounds.height - fontSize) / 2,
-             fontSize, button->textColor);
-    return clicked;
+    int fontSize = GLYPH_LABEL_SIZE;
+    float tw = (button->labelWidth > 0) ? button->labelWidth : glyphs_measure(button->label, fontSize);
+    glyphs_draw(button->label,
+                (int)(button->bounds.x + (button->bounds.width - tw) / 2),
+                (int)(button->bounds.y + (button->bounds.height - fontSize) / 2),
+                fontSize, button->textColor);
+    PERF_DRAWS(3);
+}
+
+
+bool btn_draw(Button *button) {
+    Vector2 mp = GetMousePosition();
+    btn_render(button, btn_state(button, mp, IsMouseButtonDown(MOUSE_LEFT_BUTTON)));
+    return CheckCollisionPointRec(mp, button->bounds) && IsMouseButtonReleased(MOUSE_LEFT_BUTTON);
 }
\ No newline at end of file
@@ -18,10 +18,21 @@ typedef struct {
     const char *label;
     Color       baseColor;
     Color       textColor;
+    char        key;        // calc_press_key() byte, 0 for none
+    float       labelWidth; // set by btn_measure(), 0 until then
 } Button;
 
-Color btn_shade(Color color, float factor);
-bool  btn_draw (Button *button);
+typedef enum {
+    BTN_IDLE,
+    BTN_HOVER,
+    BTN_PRESSED
+} BtnState;
+
+Color    btn_shade  (Color color, float factor);
+void     btn_measure(Button *button);
+BtnState btn_state  (const Button *button, Vector2 mouse, bool mouseDown);
+void     btn_render (const Button *button, BtnState state);
+bool     btn_draw   (Button *button);
 
 
 #endif //RAYLIBPROJEKT_BUTTON_H
\ No newline at end of file
@@ -7,59 +7,31 @@
  **********************************************************************************************************************/
 
 #include "calc.h"
+#include "numfmt.h"
 
 #include <string.h>
-#include <stdio.h>
 #include <math.h>
 
 
 double parse_number(const char *str) {
-    char tmp[128];
-    size_t strLength = strlen(str);
-
-    if(strLength >= sizeof(tmp)) {
-        strLength = sizeof(tmp) - 1;
-    }
-
-    memcpy(tmp, str, strLength);
-    tmp[strLength] = '\0';
-
-    for(char *p = tmp; *p; ++p) {
-        if (*p == ',') *p = '.';
-    }
-
-    char *end = NULL;
-    double value = strtod(tmp, &end);
-    if(end == tmp) return 0.0;
-    return value;
+    return numfmt_parse(str, strlen(str), NULL);
 }
 
 
 void format_number(char *outStr, size_t cap, double value) {
-    char tmpStr[128];
-    snprintf(tmpStr, sizeof(tmpStr), "%.15g", value);
-    size_t strLength = strlen(tmpStr);
-
-    if((strLength + 1) > cap) {
-        strLength = cap - 1;
-    }
-
-    for(size_t i=0; i< strLength; i++) {
-        if(tmpStr[i] == '.') {
-            outStr[i] = ',';
-        } else {
-            outStr[i] = tmpStr[i];
-        }
-    }
-
-    outStr[strLength] = '\0';
+    numfmt_format(outStr, cap, value, NUMFMT_DISPLAY_DIGITS);
 }
 
 
 void set_display(Calc *calc, const char *text) {
-    char* string = calc->display;
+    size_t strLength = strlen(text);
 
-    snprintf(string, sizeof(string), "%s", text);
+    if((strLength + 1) > sizeof(calc->display)) {
+        strLength = sizeof(calc->display) - 1;
+    }
+
+    memcpy(calc->display, text, strLength);
+    calc->display[strLength] = '\0';
 }
 
 
@@ -97,6 +69,27 @@ void append_comma(Calc *calc) {
 }
 
 
+/* Whole-number version of eval(): false when the result overflows or is not a whole number, for division by zero,
+ * which then takes the double path to its NaN, and where doubles give -0 (the display has always shown it). */
+bool eval_int(int64_t left, int64_t right, char op, int64_t *result) {
+    switch (op) {
+        case '+': return !__builtin_add_overflow(left, right, result);
+        case '-': return !__builtin_sub_overflow(left, right, result);
+        case '*':
+            if((left == 0 && right < 0) || (right == 0 && left < 0)) return false;
+            return !__builtin_mul_overflow(left, right, result);
+        case '/':
+            if(right == 0 || (left == INT64_MIN && right == -1) || left % right != 0) return false;
+            if(left == 0 && right < 0) return false;
+            *result = left / right;
+            return true;
+        default:
+            *result = right;
+            return true;
+    }
+}
+
+
 double eval(double left, double right, char op) {
     switch (op) {
         case '+': return left + right;
@@ -108,15 +101,174 @@ double eval(double left, double right, char op) {
 }
 
 
-void calc_init(Calc *calc) {
+/* The arena lives inside Calc, so a copied Calc still points at the original's limbs. dec_arena_keep() always
+ * leaves accDec at the start of the arena, which makes re-pointing both cheap. */
+static DecArena *calc_arena(Calc *calc) {
+    if(calc->arena.base != calc->arenaLimbs) {
+        dec_arena_init(&calc->arena, calc->arenaLimbs, CALC_ARENA_LIMBS);
+        if(calc->accDec.limbs) {
+            calc->accDec.limbs = calc->arenaLimbs;
+            calc->arena.used   = calc->accDec.nlimbs;
+        }
+    }
+    return &calc->arena;
+}
+
+
+static void calc_reset(Calc *calc) {
     calc->acc         = 0.0;
+    calc->accInt      = 0;
+    calc->accExact    = true;
     calc->pending     = 0;
     calc->enteringNew = true;
     calc->lastWasEq   = false;
+    dec_zero(&calc->accDec);
+    dec_arena_reset(calc_arena(calc));
     set_display(calc, "0");
 }
 
 
+static void calc_error(Calc *calc) {
+    set_display(calc, "Error");
+    calc->acc      = 0.0;
+    calc->accInt   = 0;
+    calc->accExact = true;
+    dec_zero(&calc->accDec);
+    dec_arena_reset(calc_arena(calc));
+}
+
+
+static void calc_store_dec(Calc *calc, Dec *value) {
+    calc->accDec = *value;
+    dec_arena_keep(calc_arena(calc), &calc->accDec);
+    calc->acc = dec_to_double(&calc->accDec);
+    calc->accExact = false;
+    dec_format(calc->display, sizeof(calc->display), &calc->accDec);
+}
+
+
+/* Whole numbers are kept as int64_t and shown with all digits, also beyond 2^53. */
+static void calc_store_int(Calc *calc, int64_t value) {
+    calc->accInt   = value;
+    calc->accExact = true;
+    calc->acc      = (double)value;
+    numfmt_format_int(calc->display, sizeof(calc->display), value);
+}
+
+
+static void calc_store_double(Calc *calc, double value) {
+    calc->acc      = value;
+    calc->accExact = false;
+    format_number(calc->display, sizeof(calc->display), value);
+}
+
+
+/* The display as a number; `exact` tells whether it is a whole number held in `whole`. */
+static double display_value(const Calc *calc, int64_t *whole, bool *exact) {
+    *exact = numfmt_parse_int(calc->display, strlen(calc->display), whole);
+    return *exact ? (double)*whole : parse_number(calc->display);
+}
+
+
+void calc_init(Calc *calc) {
+    calc->backend    = CALC_DEFAULT_BACKEND;
+    calc->history    = NULL;
+    calc->arena.base = NULL;
+    dec_zero(&calc->accDec);
+    calc_reset(calc);
+}
+
+
+/* Switching backends starts over, like AC. */
+void calc_set_backend(Calc *calc, CalcBackend backend) {
+    calc->backend = backend;
+    calc_reset(calc);
+}
+
+
+void calc_set_history(Calc *calc, History *history) {
+    calc->history = history;
+}
+
+
+/* Before the result replaces acc. Exact whole numbers go on the tape as int64_t, with all the digits they showed. */
+static void calc_record(const Calc *calc, double right, int64_t rightInt, bool rightExact,
+                        double result, int64_t resultInt, bool resultExact) {
+    if(!calc->history) return;
+    HistoryValue left, r, res;
+    unsigned flags = (calc->accExact ? HISTORY_LEFT_INT : 0u) | (rightExact ? HISTORY_RIGHT_INT : 0u)
+                   | (resultExact ? HISTORY_RESULT_INT : 0u);
+
+    if(calc->accExact) left.i = calc->accInt;
+    else               left.d = calc->acc;
+    if(rightExact)     r.i    = rightInt;
+    else               r.d    = right;
+    if(resultExact)    res.i  = resultInt;
+    else               res.d  = result;
+    history_append(calc->history, left, calc->pending, r, res, flags);
+}
+
+
+/* Before the result replaces accDec, which is the left operand. */
+static void calc_record_dec(const Calc *calc, const Dec *right, const Dec *result) {
+    if(!calc->history) return;
+    history_append_dec(calc->history, &calc->accDec, calc->pending, right, result);
+}
+
+
+static void press_op_decimal(Calc *calc, char op) {
+    DecArena *arena = calc_arena(calc);
+    Dec cur, res;
+
+    if(!dec_parse(&cur, calc->display, strlen(calc->display), arena)) {
+        calc_error(calc);
+        calc->pending = 0;
+        calc->enteringNew = true;
+        return;
+    }
+
+    if(calc->pending && !calc->enteringNew) {
+        if(!dec_eval(&res, &calc->accDec, &cur, calc->pending, arena)) {
+            calc_record_dec(calc, &cur, NULL);
+            calc_error(calc);
+            calc->pending = 0;
+            calc->enteringNew = true;
+            return;
+        }
+        calc_record_dec(calc, &cur, &res);
+        calc_store_dec(calc, &res);
+    } else if(!calc->pending) {
+        calc->accDec = cur;
+        dec_arena_keep(arena, &calc->accDec);
+        calc->acc = dec_to_double(&calc->accDec);
+    } else {
+        dec_arena_keep(arena, &calc->accDec);
+    }
+    calc->pending     = op;
+    calc->enteringNew = true;
+    calc->lastWasEq   = false;
+}
+
+
+static void press_eq_decimal(Calc *calc) {
+    DecArena *arena = calc_arena(calc);
+    Dec right, result;
+
+    bool parsed = dec_parse(&right, calc->display, strlen(calc->display), arena);
+    if(parsed && dec_eval(&result, &calc->accDec, &right, calc->pending, arena)) {
+        calc_record_dec(calc, &right, &result);
+        calc_store_dec(calc, &result);
+    } else {
+        calc_record_dec(calc, parsed ? &right : NULL, NULL);
+        calc_error(calc);
+    }
+
+    calc->pending     = 0;
+    calc->enteringNew = true;
+    calc->lastWasEq   = true;
+}
+
+
 void calc_press_digit(Calc *calc, char digit) {
     if(digit < '0' || digit > '9') return;
     append_digit(calc, digit);
@@ -136,21 +288,33 @@ void calc_press_comma(Calc *calc) {
 
 void calc_press_op(Calc *calc, char op) {
     if(op != '+' && op != '-' && op != '*' && op != '/') return;
-    double cur = parse_number(calc->display);
+    if(calc->backend == CALC_BACKEND_DECIMAL) {
+        press_op_decimal(calc, op);
+        return;
+    }
+    int64_t curInt, resInt;
+    bool curExact;
+    double cur = display_value(calc, &curInt, &curExact);
 
     if(calc->pending && !calc->enteringNew) {
-        double res = eval(calc->acc, cur, calc->pending);
-        if(isnan(res)) {
-            set_display(calc, "Error");
-            calc->acc = 0.0;
-            calc->pending = 0;
-            calc->enteringNew = true;
-            return;
+        if(calc->accExact && curExact && eval_int(calc->accInt, curInt, calc->pending, &resInt)) {
+            calc_record(calc, cur, curInt, true, 0.0, resInt, true);
+            calc_store_int(calc, resInt);
+        } else {
+            double res = eval(calc->acc, cur, calc->pending);
+            calc_record(calc, cur, curInt, curExact, res, 0, false);
+            if(isnan(res)) {
+                calc_error(calc);
+                calc->pending = 0;
+                calc->enteringNew = true;
+                return;
+            }
+            calc_store_double(calc, res);
         }
-        calc->acc = res;
-        format_number(calc->display, sizeof(calc->display), res);
     } else if(!calc->pending) {
-        calc->acc = cur;
+        calc->acc      = cur;
+        calc->accInt   = curExact ? curInt : 0;
+        calc->accExact = curExact;
     }
     calc->pending     = op;
     calc->enteringNew = true;
@@ -160,14 +324,22 @@ void calc_press_op(Calc *calc, char op) {
 
 void calc_press_eq(Calc *calc) {
     if(!calc->pending) return;
-    double right = parse_number(calc->display);
-    double result = eval(calc->acc, right, calc->pending);
-    if (isnan(result)) {
-        set_display(calc, "Error");
-        calc->acc = 0.0;
+    if(calc->backend == CALC_BACKEND_DECIMAL) {
+        press_eq_decimal(calc);
+        return;
+    }
+    int64_t rightInt, resultInt;
+    bool rightExact;
+    double right = display_value(calc, &rightInt, &rightExact);
+
+    if(calc->accExact && rightExact && eval_int(calc->accInt, rightInt, calc->pending, &resultInt)) {
+        calc_record(calc, right, rightInt, true, 0.0, resultInt, true);
+        calc_store_int(calc, resultInt);
     } else {
-        calc->acc = result;
-        format_number(calc->display, sizeof(calc->display), result);
+        double result = eval(calc->acc, right, calc->pending);
+        calc_record(calc, right, rightInt, rightExact, result, 0, false);
+        if(isnan(result)) calc_error(calc);
+        else              calc_store_double(calc, result);
     }
 
     calc->pending     = 0;
@@ -177,7 +349,7 @@ void calc_press_eq(Calc *calc) {
 
 
 void calc_press_ac(Calc *calc) {
-    calc_init(calc);
+    calc_reset(calc);
 
     calc->enteringNew = true;
     calc->lastWasEq   = false;
@@ -204,6 +376,20 @@ void calc_press_sign(Calc *calc) {
 
 
 void calc_press_pct(Calc *calc) {
+    if(calc->backend == CALC_BACKEND_DECIMAL) {
+        DecArena *arena = calc_arena(calc);
+        Dec current;
+        if(dec_parse(&current, calc->display, strlen(calc->display), arena) && dec_pct(&current, &current)) {
+            dec_format(calc->display, sizeof(calc->display), &current);
+        } else {
+            set_display(calc, "Error");
+        }
+        dec_arena_keep(arena, &calc->accDec);
+
+        calc->enteringNew = true;
+        calc->lastWasEq   = true;
+        return;
+    }
     double current = parse_number(calc->display);
     current /= 100.0;
     format_number(calc->display, sizeof(calc->display), current);
@@ -215,7 +401,7 @@ void calc_press_pct(Calc *calc) {
 
 void calc_press_backspace(Calc *calc) {
     if(strcmp(calc->display, "0") == 0 || strcmp(calc->display, "Error") == 0) {
-        calc_init(calc);
+        calc_reset(calc);
         return;
     }
 
@@ -240,3 +426,39 @@ void calc_press_backspace(Calc *calc) {
     calc->enteringNew = true;
     calc->lastWasEq   = false;
 }
+
+
+bool calc_press_key(Calc *calc, char key) {
+    switch (key) {
+        case '0': case '1': case '2': case '3': case '4':
+        case '5': case '6': case '7': case '8': case '9':
+            calc_press_digit(calc, key);
+            return true;
+        case ',': case '.':
+            calc_press_comma(calc);
+            return true;
+        case '+': case '-': case '*': case '/':
+            calc_press_op(calc, key);
+            return true;
+        case 'x': case 'X':
+            calc_press_op(calc, '*');
+            return true;
+        case CALC_KEY_EQ:
+            calc_press_eq(calc);
+            return true;
+        case CALC_KEY_AC: case 'c':
+            calc_press_ac(calc);
+            return true;
+        case CALC_KEY_SIGN:
+            calc_press_sign(calc);
+            return true;
+        case CALC_KEY_PCT:
+            calc_press_pct(calc);
+            return true;
+        case CALC_KEY_BACKSPACE:
+            calc_press_backspace(calc);
+            return true;
+        default:
+            return false;
+    }
+}
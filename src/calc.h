@@ -13,25 +13,59 @@
 #pragma once
 #include <stdbool.h>
 #include <stdlib.h>
+#include "decimal.h"
+#include "history.h"
+
+typedef enum {
+    CALC_BACKEND_DOUBLE,
+    CALC_BACKEND_DECIMAL
+} CalcBackend;
+
+#ifndef CALC_DEFAULT_BACKEND
+#define CALC_DEFAULT_BACKEND CALC_BACKEND_DOUBLE
+#endif
+
+#define CALC_ARENA_LIMBS 32     // acc, operand and result at DEC_MAX_LIMBS each, with room to spare
 
 typedef struct {
     double acc;
+    int64_t accInt;                             // acc exactly, while accExact (double backend)
+    bool   accExact;
     char   pending;
     bool   enteringNew;
     char   display[64];
     bool   lastWasEq;
+
+    CalcBackend backend;
+    Dec         accDec;                         // exact acc while backend == CALC_BACKEND_DECIMAL
+    DecArena    arena;
+    uint32_t    arenaLimbs[CALC_ARENA_LIMBS];
+
+    History    *history;                        // completed calculations are appended here, NULL for none
 }
 
 Calc;
 
+/* One byte per keystroke, as understood by calc_press_key(). Digits, ',' and
+ * the operators '+', '-', '*', '/' map to themselves ('.' and 'x' are accepted
+ * as aliases for ',' and '*'). */
+#define CALC_KEY_EQ        '='
+#define CALC_KEY_AC        'C'
+#define CALC_KEY_SIGN      '~'
+#define CALC_KEY_PCT       '%'
+#define CALC_KEY_BACKSPACE '<'
+
 double parse_number (const char *str);
 void   format_number(char *outStr, size_t cap, double value);
 void   set_display  (Calc *calc, const char *text);
 void   append_digit (Calc *calc, char value);
 void   append_comma (Calc *calc);
 double eval         (double left, double right, char op);
+bool   eval_int     (int64_t left, int64_t right, char op, int64_t *result);
 
 void calc_init       (Calc *calc);
+void calc_set_backend(Calc *calc, CalcBackend backend);
+void calc_set_history(Calc *calc, History *history);
 void calc_press_digit(Calc *calc, char digit);
 void calc_press_comma(Calc *calc);
 void calc_press_op   (Calc *calc, char op);
@@ -40,5 +74,6 @@ void calc_press_ac   (Calc *calc);
 void calc_press_sign (Calc *calc);
 void calc_press_pct  (Calc *calc);
 void calc_press_backspace(Calc *calc);
+bool calc_press_key  (Calc *calc, char key);
 
 #endif //RAYLIBPROJEKT_CALC_H
\ No newline at end of file
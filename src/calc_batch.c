@@ -0,0 +1,567 @@
+/***********************************************************************************************************************
+ * @author Christian Reiswich
+ * @date 18 Oct. 2026
+ * @version 1.0
+ * @brief Raylib Calculator
+ * @details Headless keypress replay. Every input line is one session: its keys are fed through calc_press_key()
+ *          and the resulting display is written as one output line. Input and output go through large blocks,
+ *          so there is no stdio call and no allocation per line or per key.
+ *
+ *          With -e every line is an expression instead, with -f the formula is compiled once and every line
+ *          holds the values of its names (separated by blanks or ';', in order of first use). Formula rows are
+ *          evaluated in batches, as native code where jit.h supports the target.
+ *          -d replays the keys on the decimal backend instead of doubles.
+ *
+ *          With -j the input is cut into chunks of whole lines that a work-stealing pool evaluates in parallel,
+ *          each chunk with its own Calc. Finished chunks wait in a ring of slots until all earlier ones are
+ *          written, so the output keeps the input order.
+ *
+ *          With -s the lines build a sheet of named cells: "name = formula" sets a cell and prints its value after
+ *          the incremental recalc, a bare "name" prints the current value. Sheets always run on one thread.
+ *
+ *          -H appends every completed calculation of the key replay to a history tape (history.h); like -s it
+ *          keeps the replay on one thread, so the tape is in input order.
+ *
+ *          Usage: calc_batch [-v] [-d] [-j threads] [-o out] [-H tape] [-e | -f formula | -s] [file]
+ **********************************************************************************************************************/
+
+#include "calc.h"
+#include "expr.h"
+#include "history.h"
+#include "jit.h"
+#include "pool.h"
+#include "sheet.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+
+
+#define BATCH_BLOCK (1u << 20)
+#define CHUNK_BYTES (256u << 10)
+#define SLOTS_PER_THREAD 4
+
+static char inBuf [BATCH_BLOCK];
+static char outBuf[BATCH_BLOCK];
+
+
+typedef struct {
+    FILE  *out;         // NULL: collect in buf, which then grows as needed
+    char  *buf;
+    size_t cap;
+    size_t used;
+    bool   failed;
+} Output;
+
+
+static void out_flush(Output *o) {
+    if(!o->out) return;
+    if(o->used && fwrite(o->buf, 1, o->used, o->out) != o->used) o->failed = true;
+    o->used = 0;
+}
+
+
+static bool out_reserve(Output *o, size_t n) {
+    if(o->used + n <= o->cap) return true;
+    if(o->out) {
+        out_flush(o);
+        return n <= o->cap;
+    }
+
+    size_t cap = o->cap ? o->cap : 4096;
+    while(cap < o->used + n) cap *= 2;
+    char *buf = realloc(o->buf, cap);
+    if(!buf) {
+        o->failed = true;
+        return false;
+    }
+    o->buf = buf;
+    o->cap = cap;
+    return true;
+}
+
+
+static void out_line(Output *o, const char *text) {
+    size_t strLength = strlen(text);
+    if(!out_reserve(o, strLength + 1)) return;
+
+    memcpy(o->buf + o->used, text, strLength);
+    o->used += strLength;
+    o->buf[o->used++] = '\n';
+}
+
+
+static void out_bytes(Output *o, const char *data, size_t n) {
+    out_flush(o);
+    if(n && fwrite(data, 1, n, o->out) != n) o->failed = true;
+}
+
+
+static void out_value(Output *o, double value) {
+    char text[64];
+    if(isnan(value)) {
+        out_line(o, "Error");
+        return;
+    }
+    format_number(text, sizeof(text), value);
+    out_line(o, text);
+}
+
+
+static void eval_line(Output *o, char *line) {
+    ExprProgram prog;
+    if(!expr_compile(&prog, line) || prog.varCount > 0) {
+        out_line(o, "Error");
+        return;
+    }
+    out_value(o, expr_run(&prog, NULL));
+}
+
+
+#define FORMULA_ROWS 256       // rows per jit_run_batch() call
+
+typedef struct {
+    double vars[FORMULA_ROWS][EXPR_MAX_VARS];
+    double out [FORMULA_ROWS];
+    bool   ok  [FORMULA_ROWS];
+    int    count;
+} FormulaBatch;
+
+
+/* Parses the values of one line into the next batch row; the row is evaluated with the others in formula_flush(). */
+static void formula_line(FormulaBatch *b, const ExprProgram *prog, char *line) {
+    double *vars = b->vars[b->count];
+    int count = 0;
+    char *p = line;
+
+    for(;;) {
+        while(*p == ' ' || *p == '\t' || *p == ';') p++;
+        if(*p == '\0') break;
+
+        char *field = p;
+        while(*p && *p != ' ' && *p != '\t' && *p != ';') p++;
+        char saved = *p;
+        *p = '\0';
+        if(count < EXPR_MAX_VARS) vars[count] = parse_number(field);
+        count++;
+        *p = saved;
+    }
+
+    b->ok[b->count] = (count == prog->varCount);
+    if(!b->ok[b->count]) memset(vars, 0, sizeof(b->vars[0]));
+    b->count++;
+}
+
+
+typedef struct {
+    const ExprProgram *formula;     // -f
+    const JitProgram  *jit;         // native code for the formula, fn is NULL without
+    Sheet             *sheet;       // -s
+    bool               exprMode;    // -e
+    bool               decimal;     // -d
+    bool               verbose;     // -v: why a sheet line failed, on stderr
+} Mode;
+
+typedef struct {
+    unsigned long long keys;
+    unsigned long long lines;
+    unsigned long long skipped;
+} Counts;
+
+
+/* Keystrokes, one session per line; the Calc carries over between calls so blocks may split a line. */
+static void replay_keys(Output *o, Calc *calc, bool *lineOpen, const char *p, size_t n, Counts *c) {
+    for(size_t i = 0; i < n; i++) {
+        char ch = p[i];
+        if(ch == '\n') {
+            out_line(o, calc->display);
+            calc_press_ac(calc);
+            c->lines++;
+            *lineOpen = false;
+        } else if(ch == '\r' || ch == ' ' || ch == '\t') {
+            continue;
+        } else {
+            if(calc_press_key(calc, ch)) c->keys++;
+            else                         c->skipped++;
+            *lineOpen = true;
+        }
+    }
+}
+
+
+static void formula_flush(Output *o, const Mode *m, FormulaBatch *b) {
+    jit_run_batch(m->jit, m->formula, &b->vars[0][0], EXPR_MAX_VARS, b->out, (size_t)b->count);
+    for(int i = 0; i < b->count; i++) {
+        if(b->ok[i]) out_value(o, b->out[i]);
+        else         out_line(o, "Error");
+    }
+    b->count = 0;
+}
+
+
+static char *trim(char *p, char *end) {
+    while(p < end && (*p == ' ' || *p == '\t')) p++;
+    while(end > p && (end[-1] == ' ' || end[-1] == '\t')) end--;
+    *end = '\0';
+    return p;
+}
+
+
+/* "name = formula" or just "name"; either way the line prints the value of the cell. A rejected formula prints
+ * "Error" like a failed calculation; with -v the reason goes to stderr. */
+static void sheet_line(Output *o, const Mode *m, char *line, unsigned long long lineNo) {
+    Sheet *sheet = m->sheet;
+    char *eq   = strchr(line, '=');
+    char *name = trim(line, eq ? eq : line + strlen(line));
+
+    if(eq) {
+        SheetStatus status = sheet_set(sheet, name, eq + 1);
+        if(status != SHEET_OK) {
+            if(m->verbose) fprintf(stderr, "line %llu: %s: %s\n", lineNo, name, sheet_status_text(status));
+            out_line(o, "Error");
+            return;
+        }
+        sheet_recalc(sheet);
+    }
+    out_value(o, sheet_get(sheet, name));
+}
+
+
+/* Expression, formula or sheet lines in [line, stop). Without `final` a trailing partial line is left alone; returns
+ * where the unprocessed rest starts. With `final` the byte at stop must be writable. */
+static char *run_lines(Output *o, const Mode *m, char *line, char *stop, bool final, Counts *c) {
+    FormulaBatch batch;
+    batch.count = 0;
+
+    while(line < stop) {
+        char *nl = memchr(line, '\n', (size_t)(stop - line));
+        if(!nl) {
+            if(!final) break;
+            nl = stop;
+        }
+        if(nl > line && nl[-1] == '\r') nl[-1] = '\0';
+        *nl = '\0';
+
+        if(m->formula) {
+            formula_line(&batch, m->formula, line);
+            if(batch.count == FORMULA_ROWS) formula_flush(o, m, &batch);
+        } else if(m->sheet) {
+            sheet_line(o, m, line, c->lines + 1);
+        } else {
+            eval_line(o, line);
+        }
+        c->lines++;
+        line = nl + 1;
+    }
+    if(batch.count) formula_flush(o, m, &batch);
+    return (line < stop) ? line : stop;
+}
+
+
+static void run_chunk(const Mode *m, Output *o, char *p, size_t n, Counts *c) {
+    if(m->exprMode || m->formula) {
+        run_lines(o, m, p, p + n, true, c);
+        return;
+    }
+
+    Calc calc;
+    calc_init(&calc);
+    if(m->decimal) calc_set_backend(&calc, CALC_BACKEND_DECIMAL);
+
+    bool lineOpen = false;
+    replay_keys(o, &calc, &lineOpen, p, n, c);
+    if(lineOpen) {
+        out_line(o, calc.display);
+        c->lines++;
+    }
+}
+
+
+/* ---------------------------------------------------------------------------------------------------------------- */
+/* Parallel mode                                                                                                     */
+/* ---------------------------------------------------------------------------------------------------------------- */
+
+struct Batch;
+
+typedef struct {
+    struct Batch *batch;
+    char         *in;
+    size_t        inLen;
+    size_t        inCap;
+    Output        out;
+    Counts        counts;
+    bool          done;
+} Slot;
+
+typedef struct Batch {
+    const Mode     *mode;
+    pthread_mutex_t lock;
+    pthread_cond_t  doneCond;
+} Batch;
+
+
+static void slot_task(void *arg) {
+    Slot *s = arg;
+    s->out.used = 0;
+    memset(&s->counts, 0, sizeof(s->counts));
+    run_chunk(s->batch->mode, &s->out, s->in, s->inLen, &s->counts);
+
+    pthread_mutex_lock(&s->batch->lock);
+    s->done = true;
+    pthread_cond_broadcast(&s->batch->doneCond);
+    pthread_mutex_unlock(&s->batch->lock);
+}
+
+
+static bool grow(char **buf, size_t *cap, size_t need) {
+    if(need <= *cap) return true;
+    size_t newCap = *cap ? *cap : CHUNK_BYTES;
+    while(newCap < need) newCap *= 2;
+    char *p = realloc(*buf, newCap);
+    if(!p) return false;
+    *buf = p;
+    *cap = newCap;
+    return true;
+}
+
+
+/* Fills a slot with the carried-over rest plus whole lines from the input. The partial last line becomes the
+ * new rest. Returns the number of bytes in the slot, 0 at the end of the input, or -1 when out of memory. */
+static long slot_fill(Slot *s, FILE *in, char **rest, size_t *restLen, size_t *restCap) {
+    if(!grow(&s->in, &s->inCap, *restLen + CHUNK_BYTES + 1)) return -1;
+    memcpy(s->in, *rest, *restLen);
+    size_t len = *restLen;
+    *restLen = 0;
+
+    for(;;) {
+        size_t n = fread(s->in + len, 1, s->inCap - 1 - len, in);
+        len += n;
+        if(n == 0) break;
+
+        size_t end = len;
+        while(end > 0 && s->in[end - 1] != '\n') end--;
+        if(end > 0) {
+            if(!grow(rest, restCap, len - end)) return -1;
+            memcpy(*rest, s->in + end, len - end);
+            *restLen = len - end;
+            len = end;
+            break;
+        }
+        if(!grow(&s->in, &s->inCap, s->inCap * 2)) return -1;
+    }
+    s->inLen = len;
+    return (long)len;
+}
+
+
+static bool run_parallel(const Mode *mode, FILE *in, Output *o, int threads, Counts *total) {
+    Pool pool;
+    if(!pool_init(&pool, threads)) {
+        fprintf(stderr, "cannot start threads\n");
+        return false;
+    }
+
+    int count = pool.count * SLOTS_PER_THREAD;
+    Slot *slots = calloc((size_t)count, sizeof(Slot));
+    Batch batch = { .mode = mode };
+    pthread_mutex_init(&batch.lock, NULL);
+    pthread_cond_init(&batch.doneCond, NULL);
+
+    char  *rest = NULL;
+    size_t restLen = 0, restCap = 0;
+    unsigned long long filled = 0, written = 0;
+    bool eof = (slots == NULL), ok = (slots != NULL);
+
+    while(!eof || written < filled) {
+        if(!eof && filled - written < (unsigned long long)count) {
+            Slot *s = &slots[filled % (unsigned long long)count];
+            s->batch = &batch;
+            long n = slot_fill(s, in, &rest, &restLen, &restCap);
+            if(n <= 0) {
+                if(n < 0) ok = false;
+                eof = true;
+                continue;
+            }
+            s->done = false;
+            pool_submit(&pool, slot_task, s);
+            filled++;
+            continue;
+        }
+
+        Slot *s = &slots[written % (unsigned long long)count];
+        pthread_mutex_lock(&batch.lock);
+        while(!s->done) pthread_cond_wait(&batch.doneCond, &batch.lock);
+        pthread_mutex_unlock(&batch.lock);
+
+        out_bytes(o, s->out.buf, s->out.used);
+        if(s->out.failed) ok = false;
+        total->keys    += s->counts.keys;
+        total->lines   += s->counts.lines;
+        total->skipped += s->counts.skipped;
+        written++;
+    }
+
+    pool_destroy(&pool);
+    for(int i = 0; slots && i < count; i++) {
+        free(slots[i].in);
+        free(slots[i].out.buf);
+    }
+    free(slots);
+    free(rest);
+    pthread_cond_destroy(&batch.doneCond);
+    pthread_mutex_destroy(&batch.lock);
+    if(!ok) fprintf(stderr, "out of memory\n");
+    return ok;
+}
+
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+
+static void usage(void) {
+    fprintf(stderr, "usage: calc_batch [-v] [-d] [-j threads] [-o out] [-H tape] [-e | -f formula | -s] [file]\n"
+                    "  keys: 0-9 , + - * / %c %c(AC) %c(+/-) %c %c(backspace), one session per line\n"
+                    "  -d: decimal backend for the keys\n"
+                    "  -j: worker threads, 0 for one per CPU (default 1)\n"
+                    "  -H: append the calculations of the keys to a history tape\n"
+                    "  -e: one expression per line, -f: one set of values for the formula per line\n"
+                    "  -s: \"name = formula\" or \"name\" per line, a sheet of named cells\n",
+            CALC_KEY_EQ, CALC_KEY_AC, CALC_KEY_SIGN, CALC_KEY_PCT, CALC_KEY_BACKSPACE);
+}
+
+
+int main(int argc, char **argv) {
+    const char *inPath   = NULL;
+    const char *outPath  = NULL;
+    const char *formula  = NULL;
+    const char *tapePath = NULL;
+    bool verbose   = false;
+    bool exprMode  = false;
+    bool sheetMode = false;
+    bool decimal   = false;
+    int  threads   = 1;
+
+    for(int i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "-v") == 0) {
+            verbose = true;
+        } else if(strcmp(argv[i], "-d") == 0) {
+            decimal = true;
+        } else if(strcmp(argv[i], "-e") == 0) {
+            exprMode = true;
+        } else if(strcmp(argv[i], "-s") == 0) {
+            sheetMode = true;
+        } else if(strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+            threads = atoi(argv[++i]);
+        } else if(strcmp(argv[i], "-f") == 0 && i + 1 < argc) {
+            formula = argv[++i];
+        } else if(strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            outPath = argv[++i];
+        } else if(strcmp(argv[i], "-H") == 0 && i + 1 < argc) {
+            tapePath = argv[++i];
+        } else if(argv[i][0] == '-' && argv[i][1] != '\0') {
+            usage();
+            return 2;
+        } else {
+            inPath = argv[i];
+        }
+    }
+
+    ExprProgram prog;
+    if(formula && !expr_compile(&prog, formula)) {
+        fprintf(stderr, "formula: %s at offset %d\n", prog.error, prog.errorPos);
+        return 2;
+    }
+    JitProgram jit = { 0 };
+    if(formula && !jit_compile(&jit, &prog) && verbose) fprintf(stderr, "formula: no native code, using the VM\n");
+    Sheet sheet;
+    sheet_init(&sheet);
+    Mode mode = { .formula = formula ? &prog : NULL, .jit = &jit, .sheet = sheetMode ? &sheet : NULL,
+                  .exprMode = exprMode, .decimal = decimal, .verbose = verbose };
+    if(sheetMode || tapePath) threads = 1;
+
+    History tape;
+    if(tapePath && !history_open(&tape, tapePath)) {
+        fprintf(stderr, "%s: not a history tape\n", tapePath);
+        return 1;
+    }
+
+    FILE *in = stdin;
+    if(inPath && strcmp(inPath, "-") != 0) {
+        in = fopen(inPath, "rb");
+        if(!in) { perror(inPath); return 1; }
+    }
+
+    Output o = { .out = stdout, .buf = outBuf, .cap = sizeof(outBuf), .used = 0, .failed = false };
+    if(outPath) {
+        o.out = fopen(outPath, "wb");
+        if(!o.out) { perror(outPath); return 1; }
+    }
+
+    Counts counts = { 0, 0, 0 };
+    double start = now_sec();
+
+    if(threads != 1) {
+        if(!run_parallel(&mode, in, &o, threads, &counts)) o.failed = true;
+    } else if(exprMode || formula || sheetMode) {
+        size_t carry = 0;
+        for(;;) {
+            size_t n = fread(inBuf + carry, 1, sizeof(inBuf) - 1 - carry, in);
+            size_t avail = carry + n;
+            if(avail == 0) break;
+
+            char *stop = inBuf + avail;
+            char *rest = run_lines(&o, &mode, inBuf, stop, n == 0, &counts);
+            if(n == 0) break;
+
+            carry = (size_t)(stop - rest);
+            if(carry == sizeof(inBuf) - 1) {
+                fprintf(stderr, "line longer than %u bytes\n", BATCH_BLOCK - 1);
+                return 1;
+            }
+            memmove(inBuf, rest, carry);
+        }
+    } else {
+        Calc calc;
+        calc_init(&calc);
+        if(decimal) calc_set_backend(&calc, CALC_BACKEND_DECIMAL);
+        if(tapePath) calc_set_history(&calc, &tape);
+
+        bool lineOpen = false;
+        size_t n;
+        while((n = fread(inBuf, 1, sizeof(inBuf), in)) > 0) {
+            replay_keys(&o, &calc, &lineOpen, inBuf, n, &counts);
+        }
+        if(lineOpen) {
+            out_line(&o, calc.display);
+            counts.lines++;
+        }
+    }
+    out_flush(&o);
+
+    double elapsed = now_sec() - start;
+    if(verbose && sheetMode) {
+        fprintf(stderr, "%d cells, %llu formulas evaluated for %llu lines\n", sheet.count, sheet.evaluated, counts.lines);
+    }
+    if(verbose) {
+        fprintf(stderr, "%llu keys, %llu lines, %llu skipped in %.3f s (%.1f Mkeys/s)\n",
+                counts.keys, counts.lines, counts.skipped, elapsed,
+                elapsed > 0 ? (double)counts.keys / elapsed * 1e-6 : 0.0);
+    }
+
+    if(ferror(in)) { perror("read"); o.failed = true; }
+    if(in != stdin) fclose(in);
+    jit_free(&jit);
+    sheet_free(&sheet);
+    if(tapePath) {
+        if(verbose) fprintf(stderr, "%llu entries on the tape\n", (unsigned long long)history_count(&tape));
+        if(!history_close(&tape)) { perror(tapePath); o.failed = true; }
+    }
+    if(o.out != stdout && fclose(o.out) != 0) o.failed = true;
+    return o.failed ? 1 : 0;
+}
@@ -0,0 +1,1174 @@
+/***********************************************************************************************************************
+ * @author Christian Reiswich
+ * @date 18 Oct. 2026
+ * @version 1.0
+ * @brief Raylib Calculator
+ * @details Micro benchmarks for the engine. The legacy_* functions are the snprintf/strtod based number text
+ *          routines calc.c used before numfmt, kept here as the reference to measure against. The eval_* and
+ *          keys_* pairs compare the double and the decimal backend on the same operands and keystrokes;
+ *          keys_whole replays whole-number sessions and format_int the integer formatting they use.
+ *
+ *          On glibc malloc, calloc and realloc are wrapped to count allocations per operation. When built with
+ *          raylib, frame_* time one frame of display and keypad drawing into an offscreen texture of a hidden
+ *          window: the cached keypad against drawing all buttons every frame.
+ *
+ *          Every benchmark is timed BENCH_RUNS times and the fastest run counts; how far the median lies above it
+ *          is kept as its noise. --json prints the results as JSON, together with the build type and CPU model,
+ *          --save writes them to a file, and --baseline compares against such a file and fails when a benchmark
+ *          got slower than the tolerance (default 10 %) or twice its noise, whichever is more, or allocates more.
+ *          Both need a Release build, and a baseline from another build type or CPU is not compared at all.
+ *
+ *          formula_vm and formula_jit run the same formula through expr_run_batch() and the generated code.
+ *          sheet_edit changes one net price of a 4096 line pricing sheet and recalculates, sheet_rate changes the
+ *          rate every line depends on, which amounts to a full recalculation.
+ *
+ *          history_append records one calculation on an in-memory tape that is rewound every 2^20 entries.
+ *          stats_add and stats_add_sketch feed one value to the streaming statistics, without and with the percentile
+ *          sketch; sum_batch is the compensated sum on its own.
+ *          engine_keys pushes a keys_double session through the engine thread and waits for the snapshot that shows
+ *          it, so against keys_double it is the cost of the hand-over.
+ *          sessions_apply and sessions_calc press one key of the till-roll sessions typed by thousands of users at
+ *          once on 2^18 sessions, held in a sessions.h table (4.7 MB) and in an array of Calc (71 MB).
+ *
+ *          --check compares the generated code and the VM with eval() bit for bit (any NaN equals any NaN), on
+ *          random formulas and special values (zeros of both signs, infinities, NaN), and the session table with Calc
+ *          on random keystrokes. It exits with 1 on the first difference; no benchmark runs then. ctest runs it as
+ *          the "differential" test.
+ *
+ *          Usage: calc_bench [--json] [--save file] [--baseline file] [--tolerance pct] [--check] [filter]
+ **********************************************************************************************************************/
+
+#include "calc.h"
+#include "decimal.h"
+#include "engine.h"
+#include "expr.h"
+#include "history.h"
+#include "jit.h"
+#include "numfmt.h"
+#include "sessions.h"
+#include "sheet.h"
+#include "simd.h"
+#include "stats.h"
+
+#include <math.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef CALC_BENCH_FRAME
+#include "raylib.h"
+#include "glyphs.h"
+#include "keypad.h"
+#include "ui.h"
+#endif
+
+
+#if defined(__GLIBC__)
+#define BENCH_COUNTS_ALLOCS 1
+
+extern void *__libc_malloc (size_t size);
+extern void *__libc_calloc (size_t count, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+extern void  __libc_free   (void *ptr);
+
+static unsigned long long allocCount;
+
+void *malloc(size_t size) {
+    __atomic_fetch_add(&allocCount, 1, __ATOMIC_RELAXED);
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size) {
+    __atomic_fetch_add(&allocCount, 1, __ATOMIC_RELAXED);
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *ptr, size_t size) {
+    __atomic_fetch_add(&allocCount, 1, __ATOMIC_RELAXED);
+    return __libc_realloc(ptr, size);
+}
+
+void free(void *ptr) {
+    __libc_free(ptr);
+}
+
+static unsigned long long alloc_count(void) {
+    return __atomic_load_n(&allocCount, __ATOMIC_RELAXED);
+}
+#else
+#define BENCH_COUNTS_ALLOCS 0
+
+static unsigned long long alloc_count(void) {
+    return 0;
+}
+#endif
+
+
+#define BENCH_VALUES 4096
+
+static double values[BENCH_VALUES];
+static char   texts [BENCH_VALUES][64];
+static Dec    decs  [BENCH_VALUES];
+static uint32_t decLimbs[BENCH_VALUES * DEC_MAX_LIMBS];
+static const char ops[4] = { '+', '-', '*', '/' };
+
+/* Short till-roll sessions: amounts with cents, a quantity, a percentage and a division. */
+static const char *const sessions[] = {
+    "12,99+4,5+0,99*3=",
+    "1999,95-250,5=",
+    "0,1+0,2=",
+    "1234567,89*19%",
+    "100/3*3=",
+    "250000*0,035/12=",
+    "9,99+9,99+9,99+9,99+9,99=",
+    "7~*6<42=",
+};
+/* Whole-number sessions, which take the int64_t path of the double backend. */
+static const char *const wholeSessions[] = {
+    "125*8=",
+    "1999+1-250=",
+    "123456789*1000=",
+    "7~*6=",
+    "86400*365*100=",
+    "144/12/3=",
+};
+static volatile double sinkValue;
+static volatile size_t sinkSize;
+
+
+static double legacy_parse_number(const char *str) {
+    char tmp[128];
+    size_t strLength = strlen(str);
+
+    if(strLength >= sizeof(tmp)) {
+        strLength = sizeof(tmp) - 1;
+    }
+
+    memcpy(tmp, str, strLength);
+    tmp[strLength] = '\0';
+
+    for(char *p = tmp; *p; ++p) {
+        if (*p == ',') *p = '.';
+    }
+
+    char *end = NULL;
+    double value = strtod(tmp, &end);
+    if(end == tmp) return 0.0;
+    return value;
+}
+
+
+static void legacy_format_number(char *outStr, size_t cap, double value) {
+    char tmpStr[128];
+    snprintf(tmpStr, sizeof(tmpStr), "%.15g", value);
+    size_t strLength = strlen(tmpStr);
+
+    if((strLength + 1) > cap) {
+        strLength = cap - 1;
+    }
+
+    for(size_t i=0; i< strLength; i++) {
+        if(tmpStr[i] == '.') {
+            outStr[i] = ',';
+        } else {
+            outStr[i] = tmpStr[i];
+        }
+    }
+
+    outStr[strLength] = '\0';
+}
+
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+
+/* Typical calculator values: short decimals, integers and a share of full precision quotients. */
+static void make_values(void) {
+    uint64_t s = 0x9E3779B97F4A7C15ull;
+    for(int i = 0; i < BENCH_VALUES; i++) {
+        s ^= s << 13; s ^= s >> 7; s ^= s << 17;
+        switch (i % 4) {
+            case 0:  values[i] = (double)(s % 1000000) / 100.0;                   break;
+            case 1:  values[i] = (double)(s % 100000);                            break;
+            case 2:  values[i] = (double)(s % 100000) / (double)(s % 97 + 3);     break;
+            default: values[i] = (double)(int64_t)(s % 2000001 - 1000000) * 1e-3; break;
+        }
+        format_number(texts[i], sizeof(texts[i]), values[i]);
+    }
+
+    DecArena arena;
+    dec_arena_init(&arena, decLimbs, sizeof(decLimbs) / sizeof(decLimbs[0]));
+    for(int i = 0; i < BENCH_VALUES; i++) {
+        dec_parse(&decs[i], texts[i], strlen(texts[i]), &arena);
+    }
+}
+
+
+typedef void (*BenchFn)(int iterations);
+
+static void bench_format(int n) {
+    char out[64];
+    for(int i = 0; i < n; i++) {
+        format_number(out, sizeof(out), values[i & (BENCH_VALUES - 1)]);
+        sinkSize += (size_t)out[0];
+    }
+}
+
+static void bench_format_legacy(int n) {
+    char out[64];
+    for(int i = 0; i < n; i++) {
+        legacy_format_number(out, sizeof(out), values[i & (BENCH_VALUES - 1)]);
+        sinkSize += (size_t)out[0];
+    }
+}
+
+static void bench_format_roundtrip(int n) {
+    char out[64];
+    for(int i = 0; i < n; i++) {
+        sinkSize += numfmt_format(out, sizeof(out), values[i & (BENCH_VALUES - 1)], NUMFMT_ROUNDTRIP_DIGITS);
+    }
+}
+
+static void bench_format_int(int n) {
+    char out[32];
+    for(int i = 0; i < n; i++) {
+        sinkSize += numfmt_format_int(out, sizeof(out), (int64_t)values[i & (BENCH_VALUES - 1)] * 1000);
+    }
+}
+
+static void bench_format_int_double(int n) {
+    char out[32];
+    for(int i = 0; i < n; i++) {
+        sinkSize += numfmt_format(out, sizeof(out), (double)((int64_t)values[i & (BENCH_VALUES - 1)] * 1000),
+                                  NUMFMT_DISPLAY_DIGITS);
+    }
+}
+
+static void bench_parse(int n) {
+    double acc = 0.0;
+    for(int i = 0; i < n; i++) acc += parse_number(texts[i & (BENCH_VALUES - 1)]);
+    sinkValue = acc;
+}
+
+static void bench_parse_legacy(int n) {
+    double acc = 0.0;
+    for(int i = 0; i < n; i++) acc += legacy_parse_number(texts[i & (BENCH_VALUES - 1)]);
+    sinkValue = acc;
+}
+
+static void bench_eval_double(int n) {
+    double acc = 0.0;
+    for(int i = 0; i < n; i++) {
+        int k = i & (BENCH_VALUES - 1);
+        acc += eval(values[k], values[(k + 1) & (BENCH_VALUES - 1)], ops[i & 3]);
+    }
+    sinkValue = acc;
+}
+
+static void bench_eval_decimal(int n) {
+    uint32_t limbs[3 * DEC_MAX_LIMBS];
+    DecArena arena;
+    dec_arena_init(&arena, limbs, sizeof(limbs) / sizeof(limbs[0]));
+
+    size_t acc = 0;
+    for(int i = 0; i < n; i++) {
+        int k = i & (BENCH_VALUES - 1);
+        Dec r;
+        dec_arena_reset(&arena);
+        dec_eval(&r, &decs[k], &decs[(k + 1) & (BENCH_VALUES - 1)], ops[i & 3], &arena);
+        acc += (size_t)r.exp;
+    }
+    sinkSize = acc;
+}
+
+static void run_sessions(int n, CalcBackend backend, const char *const *list, size_t count) {
+    Calc calc;
+    calc_init(&calc);
+    calc_set_backend(&calc, backend);
+
+    size_t acc = 0;
+    for(int i = 0; i < n; i++) {
+        for(const char *p = list[i % count]; *p; p++) calc_press_key(&calc, *p);
+        acc += (size_t)calc.display[0];
+        calc_press_ac(&calc);
+    }
+    sinkSize = acc;
+}
+
+static void bench_keys_double(int n) {
+    run_sessions(n, CALC_BACKEND_DOUBLE, sessions, sizeof(sessions) / sizeof(sessions[0]));
+}
+
+static void bench_keys_decimal(int n) {
+    run_sessions(n, CALC_BACKEND_DECIMAL, sessions, sizeof(sessions) / sizeof(sessions[0]));
+}
+
+static void bench_keys_whole(int n) {
+    run_sessions(n, CALC_BACKEND_DOUBLE, wholeSessions, sizeof(wholeSessions) / sizeof(wholeSessions[0]));
+}
+
+
+#define FORMULA_BATCH 256
+
+static const char *const benchFormula = "(a + b) * c / (d - 1,5) + a% - -b";
+static ExprProgram formulaProg;
+static JitProgram  formulaJit;
+static bool        formulaReady = false;
+
+static void formula_setup(void) {
+    if(formulaReady) return;
+    expr_compile(&formulaProg, benchFormula);
+    jit_compile(&formulaJit, &formulaProg);
+    formulaReady = true;
+}
+
+/* Rows overlap: row i reads values[i .. i+3]. */
+static void run_formula(int n, const JitProgram *jit) {
+    double out[FORMULA_BATCH];
+    double acc = 0.0;
+    formula_setup();
+    for(int i = 0; i < n; i += FORMULA_BATCH) {
+        size_t rows = (n - i < FORMULA_BATCH) ? (size_t)(n - i) : FORMULA_BATCH;
+        size_t first = (size_t)i % (BENCH_VALUES - FORMULA_BATCH - 4);
+        jit_run_batch(jit, &formulaProg, values + first, 1, out, rows);
+        acc += out[0];
+    }
+    sinkValue = acc;
+}
+
+static void bench_formula_vm(int n) {
+    run_formula(n, NULL);
+}
+
+static void bench_formula_jit(int n) {
+    run_formula(n, &formulaJit);
+}
+
+
+/* rate, net0..net4095, gross<i> = net<i> * (1 + rate), and sums of 16 over three levels up to "total". */
+static Sheet pricing;
+static bool  pricingReady = false;
+
+static void pricing_setup(void) {
+    if(pricingReady) return;
+    sheet_init(&pricing);
+    sheet_set_value(&pricing, "rate", 0.19);
+
+    char name[EXPR_NAME_LEN], src[512];
+    for(int i = 0; i < BENCH_VALUES; i++) {
+        snprintf(name, sizeof(name), "net%d", i);
+        sheet_set_value(&pricing, name, values[i]);
+        snprintf(name, sizeof(name), "gross%d", i);
+        snprintf(src, sizeof(src), "net%d * (1 + rate)", i);
+        sheet_set(&pricing, name, src);
+    }
+
+    static const char *const levels[] = { "gross", "sub", "part", "total" };
+    for(int level = 1, count = BENCH_VALUES / 16; level < 4; level++, count /= 16) {
+        for(int i = 0; i < count; i++) {
+            size_t len = 0;
+            for(int k = 0; k < 16; k++) {
+                len += (size_t)snprintf(src + len, sizeof(src) - len, "%s%s%d", k ? " + " : "", levels[level - 1], i * 16 + k);
+            }
+            if(level == 3) snprintf(name, sizeof(name), "total");
+            else           snprintf(name, sizeof(name), "%s%d", levels[level], i);
+            sheet_set(&pricing, name, src);
+        }
+    }
+    sheet_recalc(&pricing);
+    pricingReady = true;
+}
+
+static void bench_sheet_edit(int n) {
+    char name[EXPR_NAME_LEN];
+    pricing_setup();
+    for(int i = 0; i < n; i++) {
+        snprintf(name, sizeof(name), "net%d", i & (BENCH_VALUES - 1));
+        sheet_set_value(&pricing, name, values[(i * 7) & (BENCH_VALUES - 1)]);
+        sinkSize += (size_t)sheet_recalc(&pricing);
+    }
+}
+
+static void bench_sheet_rate(int n) {
+    pricing_setup();
+    for(int i = 0; i < n; i++) {
+        sheet_set_value(&pricing, "rate", (i & 1) ? 0.19 : 0.07);
+        sinkSize += (size_t)sheet_recalc(&pricing);
+    }
+}
+
+
+static void bench_history_append(int n) {
+    static History tape;
+    static bool    tapeReady = false;
+    if(!tapeReady) tapeReady = history_open(&tape, NULL);
+
+    for(int i = 0; i < n; i++) {
+        if(tape.header->count == (1u << 20)) tape.header->count = 0;
+        int k = i & (BENCH_VALUES - 1);
+        HistoryValue left   = { .d = values[k] };
+        HistoryValue right  = { .d = values[(k + 1) & (BENCH_VALUES - 1)] };
+        HistoryValue result = { .d = values[(k + 2) & (BENCH_VALUES - 1)] };
+        history_append(&tape, left, ops[i & 3], right, result, 0);
+    }
+}
+
+
+/* One op is one value; the values arrive in blocks of BENCH_VALUES. */
+static Stats statsPlain;
+static Stats statsSketch;
+static bool  statsReady = false;
+
+static void run_stats(int n, Stats *stats) {
+    if(!statsReady) {
+        stats_init(&statsPlain, false);
+        stats_init(&statsSketch, true);
+        statsReady = true;
+    }
+    for(int done = 0; done < n; done += BENCH_VALUES) {
+        int block = (n - done < BENCH_VALUES) ? n - done : BENCH_VALUES;
+        stats_add(stats, values, (size_t)block);
+    }
+    sinkValue = stats_sum(stats);
+}
+
+static void bench_stats_add(int n) {
+    run_stats(n, &statsPlain);
+}
+
+static void bench_stats_add_sketch(int n) {
+    run_stats(n, &statsSketch);
+}
+
+static void bench_sum_batch(int n) {
+    double sum = 0.0, comp = 0.0;
+    for(int done = 0; done < n; done += BENCH_VALUES) {
+        int block = (n - done < BENCH_VALUES) ? n - done : BENCH_VALUES;
+        sum_batch(values, (size_t)block, &sum, &comp);
+    }
+    sinkValue = sum + comp;
+}
+
+
+static Engine   benchEngine;
+static bool     engineReady = false;
+static uint64_t enginePushed;
+
+static void bench_engine_keys(int n) {
+    if(!engineReady) engineReady = engine_start(&benchEngine, NULL);
+    if(!engineReady) return;
+
+    size_t count = sizeof(sessions) / sizeof(sessions[0]);
+    uint64_t pushed = enginePushed;
+    EngineView view;
+    size_t acc = 0;
+    for(int i = 0; i < n; i++) {
+        for(const char *p = sessions[i % count]; *p; p++) {
+            while(!engine_push(&benchEngine, *p)) sched_yield();
+            pushed++;
+        }
+        for(engine_read(&benchEngine, &view); view.keys != pushed; engine_read(&benchEngine, &view)) sched_yield();
+        acc += (size_t)view.display[0];
+
+        while(!engine_push(&benchEngine, CALC_KEY_AC)) sched_yield();
+        pushed++;
+    }
+    enginePushed = pushed;
+    sinkSize = acc;
+}
+
+static void engine_teardown(void) {
+    if(!engineReady) return;
+    engine_stop(&benchEngine);
+    engineReady = false;
+}
+
+
+#define CHECK_FORMULAS 20000
+#define CHECK_ROWS     64
+
+static const char *const checkConsts[] = { "0", "1", "2,5", "100", "0,1", "1e308", "3" };
+static const double checkSpecials[] = { 0.0, -0.0, 1.0, -1.0, 1e-310, 1e308, -1e308, INFINITY, -INFINITY, NAN };
+
+static uint64_t checkState = 0x2545F4914F6CDD1Dull;
+
+static unsigned check_rand(unsigned range) {
+    checkState ^= checkState << 13; checkState ^= checkState >> 7; checkState ^= checkState << 17;
+    return (unsigned)(checkState % range);
+}
+
+/* Appends a random expression over a, b, c and d; every operator and the unary forms show up. */
+static void random_expr(char *buf, size_t cap, size_t *len, int depth) {
+    char piece[16];
+    unsigned pick = depth > 0 ? check_rand(10) : check_rand(2);
+    switch (pick) {
+        case 0:  snprintf(piece, sizeof(piece), "%c", 'a' + (int)check_rand(4)); break;
+        case 1:  snprintf(piece, sizeof(piece), "%s", checkConsts[check_rand(sizeof(checkConsts) / sizeof(checkConsts[0]))]); break;
+        case 2:  snprintf(piece, sizeof(piece), "-");  break;
+        case 3:  piece[0] = '\0'; break;
+        default: snprintf(piece, sizeof(piece), "(");  break;
+    }
+    *len += (size_t)snprintf(buf + *len, cap - *len, "%s", piece);
+    if(pick < 2) return;
+
+    if(pick == 2) {
+        random_expr(buf, cap, len, depth - 1);
+    } else if(pick == 3) {
+        random_expr(buf, cap, len, depth - 1);
+        *len += (size_t)snprintf(buf + *len, cap - *len, "%%");
+    } else {
+        random_expr(buf, cap, len, depth - 1);
+        *len += (size_t)snprintf(buf + *len, cap - *len, " %c ", "+-*/"[pick % 4]);
+        random_expr(buf, cap, len, depth - 1);
+        *len += (size_t)snprintf(buf + *len, cap - *len, ")");
+    }
+}
+
+/* The program evaluated the way the keys would: every binary operator through eval(), the unary ones as the +/-
+ * and % keys do it. The reference for both the VM and the generated code. */
+static double eval_reference(const ExprProgram *prog, const double *vars) {
+    double stack[EXPR_MAX_STACK + 1];
+    int sp = 0;
+
+    for(int i = 0; i < prog->codeLen; i++) {
+        const ExprInsn *insn = &prog->code[i];
+        switch (insn->op) {
+            case EXPR_OP_CONST: stack[sp++] = prog->consts[insn->arg]; break;
+            case EXPR_OP_VAR:   stack[sp++] = vars[insn->arg];         break;
+            case EXPR_OP_ADD:   sp--; stack[sp - 1] = eval(stack[sp - 1], stack[sp], '+'); break;
+            case EXPR_OP_SUB:   sp--; stack[sp - 1] = eval(stack[sp - 1], stack[sp], '-'); break;
+            case EXPR_OP_MUL:   sp--; stack[sp - 1] = eval(stack[sp - 1], stack[sp], '*'); break;
+            case EXPR_OP_DIV:   sp--; stack[sp - 1] = eval(stack[sp - 1], stack[sp], '/'); break;
+            case EXPR_OP_NEG:   stack[sp - 1] = -stack[sp - 1];      break;
+            case EXPR_OP_PCT:   stack[sp - 1] = stack[sp - 1] / 100.0; break;
+            default:            break;
+        }
+    }
+    return sp ? stack[sp - 1] : 0.0;
+}
+
+
+static bool same_bits(double a, double b) {
+    return memcmp(&a, &b, sizeof(double)) == 0 || (isnan(a) && isnan(b));
+}
+
+
+/* Generated code and expr_run() against eval_reference(), compared bit for bit. Only NaNs may differ in sign and
+ * payload: with two NaN operands C leaves open which one an addition or multiplication passes on, and both display
+ * as "Error". Returns 1 on the first difference. */
+static int check_jit(void) {
+    double vars[CHECK_ROWS][EXPR_MAX_VARS];
+    double out[CHECK_ROWS];
+    int compiled = 0, fallbacks = 0;
+    size_t nSpecial = sizeof(checkSpecials) / sizeof(checkSpecials[0]);
+
+    for(int f = 0; f < CHECK_FORMULAS; f++) {
+        char src[1024];
+        size_t len = 0;
+        if(f % 100 == 0) {
+            // deeper than the registers: must be left to the VM
+            for(int k = 0; k <= JIT_MAX_STACK; k++) len += (size_t)snprintf(src + len, sizeof(src) - len, "a / (");
+            len += (size_t)snprintf(src + len, sizeof(src) - len, "b");
+            for(int k = 0; k <= JIT_MAX_STACK; k++) src[len++] = ')';
+            src[len] = '\0';
+        } else {
+            random_expr(src, sizeof(src) - 64, &len, 1 + (int)check_rand(6));
+        }
+
+        ExprProgram prog;
+        if(!expr_compile(&prog, src)) continue;
+        compiled++;
+
+        JitProgram jit;
+        if(!jit_compile(&jit, &prog)) fallbacks++;
+
+        for(int r = 0; r < CHECK_ROWS; r++) {
+            for(int v = 0; v < EXPR_MAX_VARS; v++) {
+                vars[r][v] = check_rand(3) ? checkSpecials[check_rand((unsigned)nSpecial)]
+                                           : values[check_rand(BENCH_VALUES)];
+            }
+        }
+        jit_run_batch(&jit, &prog, &vars[0][0], EXPR_MAX_VARS, out, CHECK_ROWS);
+
+        for(int r = 0; r < CHECK_ROWS; r++) {
+            double want = eval_reference(&prog, vars[r]);
+            double vm   = expr_run(&prog, vars[r]);
+            if(!same_bits(want, out[r]) || !same_bits(want, vm)) {
+                printf("jit: \"%s\" row %d: %.17g (VM %.17g), expected %.17g from eval()\n", src, r, out[r], vm, want);
+                jit_free(&jit);
+                return 1;
+            }
+        }
+        jit_free(&jit);
+    }
+    if(jit_available()) {
+        printf("jit: %d formulas x %d rows identical to eval() and expr_run(), %d left to the VM\n",
+               compiled, CHECK_ROWS, fallbacks);
+    } else {
+        printf("jit: not available on this target; the VM matches eval() on %d formulas x %d rows\n",
+               compiled, CHECK_ROWS);
+    }
+    return 0;
+}
+
+
+
+#define CHECK_SESSIONS 64
+#define CHECK_KEYS     400000
+#define CHECK_BATCH    50000
+
+static const char checkKeys[] = "0123456789,+-*/=C~%<";
+
+/* Everything calc.c keeps apart from the decimal backend; accInt only counts while accExact. */
+static bool same_calc(const Calc *a, const Calc *b) {
+    return strcmp(a->display, b->display) == 0 && a->pending == b->pending && a->enteringNew == b->enteringNew
+           && a->lastWasEq == b->lastWasEq && a->accExact == b->accExact
+           && memcmp(&a->acc, &b->acc, sizeof(double)) == 0 && (!a->accExact || a->accInt == b->accInt);
+}
+
+/* Mostly digits, now and then a run long enough to leave the compact forms. */
+static size_t check_key_run(char *out) {
+    if(check_rand(64) == 0) {
+        size_t n = 16 + check_rand(30);
+        for(size_t i = 0; i < n; i++) out[i] = (i == 3 && check_rand(2)) ? ',' : (char)('0' + check_rand(10));
+        return n;
+    }
+    out[0] = check_rand(2) ? (char)('0' + check_rand(10)) : checkKeys[check_rand(sizeof(checkKeys) - 1)];
+    return 1;
+}
+
+/* The session table against one Calc per session on random keystrokes, compared after every key; then a batch
+ * through sessions_apply() against the same keys pressed one by one. Returns 1 on the first difference. */
+static int check_sessions(void) {
+    static Calc calcs[CHECK_BATCH / 10];
+    Sessions table;
+    sessions_init(&table);
+    for(int i = 0; i < CHECK_BATCH / 10; i++) {
+        calc_init(&calcs[i]);
+        calc_set_backend(&calcs[i], CALC_BACKEND_DOUBLE);
+        if(sessions_open(&table) != i) {
+            printf("sessions: out of memory\n");
+            return 1;
+        }
+    }
+
+    char run[64];
+    Calc got;
+    for(int k = 0; k < CHECK_KEYS;) {
+        uint32_t id = check_rand(CHECK_SESSIONS);
+        size_t n = check_key_run(run);
+        for(size_t i = 0; i < n; i++, k++) {
+            calc_press_key(&calcs[id], run[i]);
+            sessions_press(&table, id, run[i]);
+            sessions_get(&table, id, &got);
+            if(!same_calc(&got, &calcs[id])) {
+                printf("sessions: key %d '%c' on session %u shows \"%s\", expected \"%s\"\n", k, run[i], id,
+                       got.display, calcs[id].display);
+                sessions_free(&table);
+                return 1;
+            }
+        }
+    }
+
+    SessionEvent *events = malloc(CHECK_BATCH * sizeof(SessionEvent));
+    if(!events) return 1;
+    for(size_t k = 0; k < CHECK_BATCH;) {
+        uint32_t id = check_rand(CHECK_BATCH / 10);
+        size_t n = check_key_run(run);
+        for(size_t i = 0; i < n && k < CHECK_BATCH; i++, k++) {
+            events[k] = (SessionEvent){ id, run[i] };
+            calc_press_key(&calcs[id], run[i]);
+        }
+    }
+    sessions_apply(&table, events, CHECK_BATCH);
+    free(events);
+    for(uint32_t id = 0; id < CHECK_BATCH / 10; id++) {
+        char shown[64];
+        sessions_display(&table, id, shown, sizeof(shown));
+        sessions_get(&table, id, &got);
+        if(strcmp(shown, calcs[id].display) != 0 || !same_calc(&got, &calcs[id])) {
+            printf("sessions: after the batch session %u shows \"%s\", expected \"%s\"\n", id, shown,
+                   calcs[id].display);
+            sessions_free(&table);
+            return 1;
+        }
+    }
+
+    printf("sessions: %d keys one by one and %d in a batch identical to Calc, %u sessions spilled at the end\n",
+           CHECK_KEYS, CHECK_BATCH, table.spillCount - table.spillFreeCount);
+    sessions_free(&table);
+    return 0;
+}
+
+
+/* Keys of the till-roll sessions from SESSIONS_STREAMS users at once, each on a random one of SESSIONS_BENCH
+ * sessions; sessions_apply and sessions_calc take the same batch, into the table and into an array of Calc. */
+#define SESSIONS_BENCH   (1 << 18)
+#define SESSIONS_EVENTS  (1 << 16)
+#define SESSIONS_STREAMS 4096
+
+static Sessions      benchTable;
+static Calc         *benchCalcs;
+static SessionEvent *benchEvents;
+static bool          sessionsReady = false;
+
+static bool sessions_setup(void) {
+    if(sessionsReady) return true;
+
+    sessions_init(&benchTable);
+    benchCalcs  = malloc(SESSIONS_BENCH * sizeof(Calc));
+    benchEvents = malloc(SESSIONS_EVENTS * sizeof(SessionEvent));
+    if(!benchCalcs || !benchEvents) return false;
+    for(int i = 0; i < SESSIONS_BENCH; i++) {
+        calc_init(&benchCalcs[i]);
+        calc_set_backend(&benchCalcs[i], CALC_BACKEND_DOUBLE);
+        if(sessions_open(&benchTable) < 0) return false;
+    }
+
+    // every session starts with AC, so the batch can be applied again and again
+    static uint32_t    streamSession[SESSIONS_STREAMS];
+    static const char *streamKey[SESSIONS_STREAMS];
+    size_t count = sizeof(sessions) / sizeof(sessions[0]);
+    for(int k = 0; k < SESSIONS_EVENTS; k++) {
+        unsigned s = check_rand(SESSIONS_STREAMS);
+        if(!streamKey[s] || *streamKey[s] == '\0') {
+            streamSession[s] = check_rand(SESSIONS_BENCH);
+            streamKey[s]     = sessions[check_rand((unsigned)count)];
+            benchEvents[k]   = (SessionEvent){ streamSession[s], CALC_KEY_AC };
+        } else {
+            benchEvents[k] = (SessionEvent){ streamSession[s], *streamKey[s]++ };
+        }
+    }
+    sessionsReady = true;
+    return true;
+}
+
+static void bench_sessions_apply(int n) {
+    if(!sessions_setup()) return;
+    for(int done = 0; done < n; done += SESSIONS_EVENTS) {
+        int block = (n - done < SESSIONS_EVENTS) ? n - done : SESSIONS_EVENTS;
+        sinkSize += sessions_apply(&benchTable, benchEvents, (size_t)block);
+    }
+}
+
+static void bench_sessions_calc(int n) {
+    if(!sessions_setup()) return;
+    for(int done = 0; done < n; done += SESSIONS_EVENTS) {
+        int block = (n - done < SESSIONS_EVENTS) ? n - done : SESSIONS_EVENTS;
+        for(int k = 0; k < block; k++) {
+            sinkSize += calc_press_key(&benchCalcs[benchEvents[k].session], benchEvents[k].key);
+        }
+    }
+}
+
+static void sessions_teardown(void) {
+    if(!sessionsReady) return;
+    sessions_free(&benchTable);
+    free(benchCalcs);
+    free(benchEvents);
+    sessionsReady = false;
+}
+
+#ifdef CALC_BENCH_FRAME
+static bool            frameReady = false;
+static RenderTexture2D frameTarget;
+static Keypad          framePad;
+static Calc            frameCalc;
+static EngineView      frameView;
+static Theme           frameTheme;
+
+static bool frame_setup(void) {
+    if(frameReady) return true;
+
+    SetTraceLogLevel(LOG_WARNING);
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    InitWindow(400, 640, "calc_bench");
+    if(!IsWindowReady()) return false;
+
+    glyphs_load();
+    frameTheme = ui_default_theme();
+    calc_init(&frameCalc);
+    for(const char *p = "1234,5678*9"; *p; p++) calc_press_key(&frameCalc, *p);
+    engine_view_of(&frameCalc, 0, &frameView);
+    keypad_init(&framePad, (Rectangle){0, 140, 400, 500}, &frameTheme);
+    keypad_refresh(&framePad, &frameView);
+    frameTarget = LoadRenderTexture(400, 640);
+    frameReady = true;
+    return true;
+}
+
+static void frame_teardown(void) {
+    if(!frameReady) return;
+    UnloadRenderTexture(frameTarget);
+    keypad_unload(&framePad);
+    glyphs_unload();
+    CloseWindow();
+    frameReady = false;
+}
+
+static void bench_frame(int n) {
+    if(!frame_setup()) return;
+    for(int i = 0; i < n; i++) {
+        framePad.hot      = i % KEYPAD_BUTTONS;
+        framePad.hotState = BTN_HOVER;
+        BeginTextureMode(frameTarget);
+        ClearBackground(frameTheme.bg);
+        ui_draw_display(&frameView, (Rectangle){0, 0, 400, 140}, GLYPH_DISPLAY_SIZE);
+        keypad_draw(&framePad);
+        EndTextureMode();
+    }
+}
+
+static void bench_frame_all_buttons(int n) {
+    if(!frame_setup()) return;
+    for(int i = 0; i < n; i++) {
+        BeginTextureMode(frameTarget);
+        ClearBackground(frameTheme.bg);
+        ui_draw_display(&frameView, (Rectangle){0, 0, 400, 140}, GLYPH_DISPLAY_SIZE);
+        for(int k = 0; k < KEYPAD_BUTTONS; k++) {
+            btn_render(&framePad.buttons[k], (k == i % KEYPAD_BUTTONS) ? BTN_HOVER : BTN_IDLE);
+        }
+        EndTextureMode();
+    }
+}
+#endif
+
+
+typedef struct {
+    const char *name;
+    BenchFn     fn;
+} Bench;
+
+static const Bench benches[] = {
+    { "format_number",           bench_format           },
+    { "format_number_legacy",    bench_format_legacy    },
+    { "format_number_roundtrip", bench_format_roundtrip },
+    { "format_int",              bench_format_int       },
+    { "format_int_double",       bench_format_int_double},
+    { "parse_number",            bench_parse            },
+    { "parse_number_legacy",     bench_parse_legacy     },
+    { "eval_double",             bench_eval_double      },
+    { "eval_decimal",            bench_eval_decimal     },
+    { "keys_double",             bench_keys_double      },
+    { "keys_decimal",            bench_keys_decimal     },
+    { "keys_whole",              bench_keys_whole       },
+    { "formula_vm",              bench_formula_vm       },
+    { "formula_jit",             bench_formula_jit      },
+    { "sheet_edit",              bench_sheet_edit       },
+    { "sheet_rate",              bench_sheet_rate       },
+    { "history_append",          bench_history_append   },
+    { "sum_batch",               bench_sum_batch        },
+    { "stats_add",               bench_stats_add        },
+    { "stats_add_sketch",        bench_stats_add_sketch },
+    { "engine_keys",             bench_engine_keys      },
+    { "sessions_apply",          bench_sessions_apply   },
+    { "sessions_calc",           bench_sessions_calc    },
+#ifdef CALC_BENCH_FRAME
+    { "frame",                   bench_frame            },
+    { "frame_all_buttons",       bench_frame_all_buttons},
+#endif
+};
+
+#define BENCH_COUNT (sizeof(benches) / sizeof(benches[0]))
+
+#define BENCH_RUNS         5        // the fastest run counts, how far the median lies above it is the noise
+#define BENCH_RUN_NS       5e7
+#define BENCH_NOISE_FACTOR 2.0      // a change within this many times the noise is not a regression
+
+#ifndef CALC_BENCH_BUILD
+#define CALC_BENCH_BUILD ""
+#endif
+
+typedef struct {
+    double nsPerOp;
+    double allocsPerOp;
+    double noisePct;
+} Result;
+
+
+static int compare_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+
+static Result run_bench(const Bench *b) {
+    int n = 1024;
+    double elapsed = 0.0;
+    unsigned long long allocs = 0;
+
+    b->fn(16);  // warm up, lazy setup is not measured
+    for(;;) {
+        unsigned long long allocStart = alloc_count();
+        double start = now_ns();
+        b->fn(n);
+        elapsed = now_ns() - start;
+        allocs  = alloc_count() - allocStart;
+        if(elapsed > BENCH_RUN_NS || n >= (1 << 28)) break;
+        n *= (elapsed < BENCH_RUN_NS / 20) ? 8 : 2;
+    }
+
+    double runs[BENCH_RUNS];
+    runs[0] = elapsed / n;
+    for(int r = 1; r < BENCH_RUNS; r++) {
+        double start = now_ns();
+        b->fn(n);
+        runs[r] = (now_ns() - start) / n;
+    }
+    qsort(runs, BENCH_RUNS, sizeof(runs[0]), compare_double);
+    return (Result){ runs[0], (double)allocs / n, (runs[BENCH_RUNS / 2] / runs[0] - 1.0) * 100.0 };
+}
+
+
+static const char *build_type(void) {
+    return CALC_BENCH_BUILD[0] ? CALC_BENCH_BUILD : "none";
+}
+
+
+/* The CPU model, so a baseline is only compared on the machine it was taken on. */
+static void cpu_name(char *out, size_t cap) {
+    snprintf(out, cap, "unknown");
+    FILE *f = fopen("/proc/cpuinfo", "r");
+    if(!f) return;
+
+    char line[256];
+    while(fgets(line, sizeof(line), f)) {
+        char *colon = strchr(line, ':');
+        if(strncmp(line, "model name", 10) != 0 || !colon) continue;
+
+        char *p = colon + 1;
+        while(*p == ' ' || *p == '\t') p++;
+        p[strcspn(p, "\n")] = '\0';
+        for(char *c = p; *c; c++) {
+            if(*c == '"' || *c == '\\') *c = ' ';
+        }
+        snprintf(out, cap, "%s", p);
+        break;
+    }
+    fclose(f);
+}
+
+
+static void write_json(FILE *out, const Result *results, const bool *ran) {
+    char cpu[128];
+    cpu_name(cpu, sizeof(cpu));
+    bool first = true;
+    fprintf(out, "{\n  \"build\": \"%s\",\n  \"cpu\": \"%s\",\n  \"benchmarks\": [\n", build_type(), cpu);
+    for(size_t i = 0; i < BENCH_COUNT; i++) {
+        if(!ran[i]) continue;
+        fprintf(out, "%s    {\"name\": \"%s\", \"ns_per_op\": %.2f, \"noise_pct\": %.1f, ", first ? "" : ",\n",
+                benches[i].name, results[i].nsPerOp, results[i].noisePct);
+        if(BENCH_COUNTS_ALLOCS) fprintf(out, "\"allocs_per_op\": %.4f}", results[i].allocsPerOp);
+        else                    fprintf(out, "\"allocs_per_op\": null}");
+        first = false;
+    }
+    fprintf(out, "\n  ]\n}\n");
+}
+
+
+/* A top-level string of what write_json() wrote, "" if it is missing. */
+static void find_meta(const char *json, const char *key, char *out, size_t cap) {
+    char pattern[32];
+    snprintf(pattern, sizeof(pattern), "\"%s\": \"", key);
+    out[0] = '\0';
+
+    const char *p = strstr(json, pattern);
+    if(!p) return;
+    p += strlen(pattern);
+    size_t len = strcspn(p, "\"\n");
+    if(len >= cap) len = cap - 1;
+    memcpy(out, p, len);
+    out[len] = '\0';
+}
+
+
+/* Reads back what write_json() wrote: one benchmark object per line. */
+static bool find_baseline(const char *json, const char *name, double *ns, double *noise, double *allocs) {
+    char key[96];
+    snprintf(key, sizeof(key), "\"name\": \"%s\"", name);
+
+    const char *p = json;
+    while((p = strstr(p, key)) != NULL) {
+        p += strlen(key);
+        if(*p != ',') continue;
+
+        const char *nsKey = strstr(p, "\"ns_per_op\":");
+        const char *noKey = strstr(p, "\"noise_pct\":");
+        const char *alKey = strstr(p, "\"allocs_per_op\":");
+        const char *eol   = strchr(p, '\n');
+        if(!nsKey || (eol && nsKey > eol)) return false;
+
+        *ns    = strtod(nsKey + 12, NULL);
+        *noise = (noKey && (!eol || noKey < eol)) ? strtod(noKey + 12, NULL) : 0.0;
+        *allocs = -1.0;
+        if(alKey && (!eol || alKey < eol)) {
+            char *end;
+            double v = strtod(alKey + 16, &end);
+            if(end != alKey + 16) *allocs = v;
+        }
+        return true;
+    }
+    return false;
+}
+
+
+static char *read_file(const char *path) {
+    FILE *f = fopen(path, "rb");
+    if(!f) return NULL;
+
+    size_t cap = 4096, len = 0;
+    char *buf = malloc(cap);
+    size_t n;
+    while(buf && (n = fread(buf + len, 1, cap - 1 - len, f)) > 0) {
+        len += n;
+        if(len + 1 == cap) {
+            char *grown = realloc(buf, cap * 2);
+            if(!grown) { free(buf); buf = NULL; break; }
+            buf = grown;
+            cap *= 2;
+        }
+    }
+    fclose(f);
+    if(buf) buf[len] = '\0';
+    return buf;
+}
+
+
+/* False, with the reason, when the baseline was taken on another build type or CPU: its numbers say nothing then. */
+static bool same_conditions(const char *json) {
+    char build[32], cpu[128], baseCpu[128];
+    find_meta(json, "build", build, sizeof(build));
+    find_meta(json, "cpu", baseCpu, sizeof(baseCpu));
+    cpu_name(cpu, sizeof(cpu));
+
+    if(strcmp(build, build_type()) != 0) {
+        fprintf(stderr, "baseline is from a \"%s\" build, this is \"%s\"\n", build, build_type());
+        return false;
+    }
+    if(strcmp(baseCpu, cpu) != 0) {
+        fprintf(stderr, "baseline is from \"%s\", this is \"%s\"\n", baseCpu, cpu);
+        return false;
+    }
+    return true;
+}
+
+
+/* Prints the comparison and returns the number of regressions. A benchmark may move by the tolerance or by
+ * BENCH_NOISE_FACTOR times its noise, whichever is more. */
+static int compare_baseline(const char *json, const Result *results, const bool *ran, double tolerance) {
+    int regressions = 0;
+    printf("\n%-26s %10s %10s %8s %8s\n", "benchmark", "baseline", "now", "change", "allowed");
+
+    for(size_t i = 0; i < BENCH_COUNT; i++) {
+        if(!ran[i]) continue;
+
+        double baseNs, baseNoise, baseAllocs;
+        if(!find_baseline(json, benches[i].name, &baseNs, &baseNoise, &baseAllocs) || baseNs <= 0.0) {
+            printf("%-26s %10s %10.1f\n", benches[i].name, "-", results[i].nsPerOp);
+            continue;
+        }
+
+        double change  = (results[i].nsPerOp / baseNs - 1.0) * 100.0;
+        double allowed = fmax(tolerance, BENCH_NOISE_FACTOR * fmax(baseNoise, results[i].noisePct));
+        bool slower = change > allowed;
+        bool allocs = BENCH_COUNTS_ALLOCS && baseAllocs >= 0.0 && results[i].allocsPerOp > baseAllocs + 0.001;
+        printf("%-26s %10.1f %10.1f %+7.1f%% %7.1f%%%s%s\n", benches[i].name, baseNs, results[i].nsPerOp, change,
+               allowed, slower ? "  SLOWER" : "", allocs ? "  MORE ALLOCS" : "");
+        if(slower || allocs) regressions++;
+    }
+    return regressions;
+}
+
+
+int main(int argc, char **argv) {
+    const char *filter   = NULL;
+    const char *savePath = NULL;
+    const char *basePath = NULL;
+    double tolerance = 10.0;
+    bool json  = false;
+    bool check = false;
+
+    for(int i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "--json") == 0) {
+            json = true;
+        } else if(strcmp(argv[i], "--save") == 0 && i + 1 < argc) {
+            savePath = argv[++i];
+        } else if(strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) {
+            basePath = argv[++i];
+        } else if(strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc) {
+            tolerance = strtod(argv[++i], NULL);
+        } else if(strcmp(argv[i], "--check") == 0) {
+            check = true;
+        } else if(argv[i][0] == '-') {
+            fprintf(stderr, "usage: calc_bench [--json] [--save file] [--baseline file] [--tolerance pct] [--check] [filter]\n");
+            return 2;
+        } else {
+            filter = argv[i];
+        }
+    }
+
+    make_values();
+    if(check) return (check_jit() || check_sessions()) ? 1 : 0;
+
+    // Numbers from an unoptimized build are no baseline for anything
+    if((savePath || basePath) && strcmp(build_type(), "Release") != 0) {
+        fprintf(stderr, "calc_bench is a \"%s\" build; --save and --baseline need CMAKE_BUILD_TYPE=Release\n",
+                build_type());
+        return 2;
+    }
+
+    Result results[BENCH_COUNT];
+    bool   ran[BENCH_COUNT];
+    for(size_t i = 0; i < BENCH_COUNT; i++) {
+        ran[i] = !filter || strstr(benches[i].name, filter);
+        if(!ran[i]) continue;
+
+        results[i] = run_bench(&benches[i]);
+        if(!json) {
+            printf("%-26s %8.1f ns/op", benches[i].name, results[i].nsPerOp);
+            if(BENCH_COUNTS_ALLOCS) printf(" %8.3f allocs/op", results[i].allocsPerOp);
+            printf("\n");
+        }
+    }
+    engine_teardown();
+    sessions_teardown();
+#ifdef CALC_BENCH_FRAME
+    frame_teardown();
+#endif
+
+    if(json) write_json(stdout, results, ran);
+
+    if(savePath) {
+        FILE *f = fopen(savePath, "wb");
+        if(!f) { perror(savePath); return 1; }
+        write_json(f, results, ran);
+        if(fclose(f) != 0) { perror(savePath); return 1; }
+    }
+
+    if(basePath) {
+        char *base = read_file(basePath);
+        if(!base) {
+            fprintf(stderr, "%s: no baseline yet, nothing to compare\n", basePath);
+            return 0;
+        }
+        if(!same_conditions(base)) {
+            fprintf(stderr, "%s: not comparable, regenerate it with the bench_baseline target\n", basePath);
+            free(base);
+            return 2;
+        }
+        int regressions = compare_baseline(base, results, ran, tolerance);
+        free(base);
+        if(regressions) {
+            fprintf(stderr, "%d benchmark(s) regressed beyond %.1f %%\n", regressions, tolerance);
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,200 @@
+/***********************************************************************************************************************
+ * @author Christian Reiswich
+ * @date 18 Oct. 2026
+ * @version 1.0
+ * @brief Raylib Calculator
+ * @details Converter and runner for the columnar file format (colfile.h).
+ *
+ *            pack:   text lines "left op right" (',' decimal separator) into a new column file
+ *            run:    computes result and error bitmap in place
+ *            unpack: writes the results as text, one line per row, "Error" for failed rows
+ *
+ *          Usage: calc_col [-v] pack in.txt out.col | run file.col | unpack file.col [out.txt]
+ **********************************************************************************************************************/
+
+#include "colfile.h"
+#include "numfmt.h"
+
+#include <fcntl.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+
+#define TEXT_BLOCK (1u << 20)
+
+static char outBuf[TEXT_BLOCK];
+static bool verbose = false;
+
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+
+static const char *skip_blanks(const char *p, const char *end) {
+    while(p < end && (*p == ' ' || *p == '\t' || *p == '\r')) p++;
+    return p;
+}
+
+
+/* One "left op right" line. Anything else becomes a row that evaluates to an error. */
+static void pack_line(ColFile *file, uint64_t row, const char *p, const char *end) {
+    size_t used;
+    double left = numfmt_parse(p, (size_t)(end - p), &used);
+    p = skip_blanks(p + used, end);
+
+    char op = (p < end) ? *p : 0;
+    bool ok = used > 0 && (op == '+' || op == '-' || op == '*' || op == '/');
+
+    double right = 0.0;
+    if(ok) {
+        p++;
+        right = numfmt_parse(p, (size_t)(end - p), &used);
+        ok = used > 0 && skip_blanks(p + used, end) == end;
+    }
+
+    file->left[row]  = ok ? left  : NAN;
+    file->right[row] = ok ? right : NAN;
+    file->ops[row]   = ok ? op    : '+';
+}
+
+
+static int cmd_pack(const char *inPath, const char *outPath) {
+    int fd = open(inPath, O_RDONLY);
+    if(fd < 0) { perror(inPath); return 1; }
+
+    struct stat st;
+    if(fstat(fd, &st) != 0) { perror(inPath); close(fd); return 1; }
+
+    size_t size = (size_t)st.st_size;
+    const char *text = NULL;
+    if(size) {
+        text = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(text == MAP_FAILED) { perror(inPath); close(fd); return 1; }
+        madvise((void *)text, size, MADV_SEQUENTIAL);
+    }
+
+    const char *end = text + size;
+    uint64_t rows = 0;
+    for(const char *p = text; p < end; rows++) {
+        const char *nl = memchr(p, '\n', (size_t)(end - p));
+        p = nl ? nl + 1 : end;
+    }
+
+    double start = now_sec();
+    ColFile file;
+    if(!colfile_create(&file, outPath, rows)) {
+        perror(outPath);
+        if(size) munmap((void *)text, size);
+        close(fd);
+        return 1;
+    }
+
+    uint64_t row = 0;
+    for(const char *p = text; p < end; row++) {
+        const char *nl = memchr(p, '\n', (size_t)(end - p));
+        const char *lineEnd = nl ? nl : end;
+        pack_line(&file, row, p, lineEnd);
+        p = nl ? nl + 1 : end;
+    }
+
+    bool ok = colfile_close(&file);
+    if(size) munmap((void *)text, size);
+    close(fd);
+    if(verbose) fprintf(stderr, "%llu rows packed in %.3f s\n", (unsigned long long)rows, now_sec() - start);
+    if(!ok) { perror(outPath); return 1; }
+    return 0;
+}
+
+
+static int cmd_run(const char *path) {
+    ColFile file;
+    if(!colfile_open(&file, path, true)) {
+        fprintf(stderr, "%s: not a writable column file\n", path);
+        return 1;
+    }
+
+    double start = now_sec();
+    uint64_t errors = colfile_compute(&file);
+    double elapsed = now_sec() - start;
+
+    if(verbose) {
+        fprintf(stderr, "%llu rows, %llu errors in %.3f s (%.1f Mrows/s)\n",
+                (unsigned long long)file.count, (unsigned long long)errors, elapsed,
+                elapsed > 0 ? (double)file.count / elapsed * 1e-6 : 0.0);
+    }
+    if(!colfile_close(&file)) { perror(path); return 1; }
+    return 0;
+}
+
+
+static int cmd_unpack(const char *path, const char *outPath) {
+    ColFile file;
+    if(!colfile_open(&file, path, false)) {
+        fprintf(stderr, "%s: not a column file\n", path);
+        return 1;
+    }
+
+    FILE *out = stdout;
+    if(outPath) {
+        out = fopen(outPath, "wb");
+        if(!out) { perror(outPath); colfile_close(&file); return 1; }
+    }
+
+    bool failed = false;
+    size_t used = 0;
+    for(uint64_t i = 0; i < file.count; i++) {
+        if(used + NUMFMT_MAX_LEN + 1 > sizeof(outBuf)) {
+            if(fwrite(outBuf, 1, used, out) != used) failed = true;
+            used = 0;
+        }
+        if(colfile_is_error(&file, i)) {
+            memcpy(outBuf + used, "Error", 5);
+            used += 5;
+        } else {
+            used += numfmt_format(outBuf + used, NUMFMT_MAX_LEN, file.result[i], NUMFMT_DISPLAY_DIGITS);
+        }
+        outBuf[used++] = '\n';
+    }
+    if(used && fwrite(outBuf, 1, used, out) != used) failed = true;
+
+    colfile_close(&file);
+    if(out != stdout && fclose(out) != 0) failed = true;
+    return failed ? 1 : 0;
+}
+
+
+static void usage(void) {
+    fprintf(stderr, "usage: calc_col [-v] pack in.txt out.col\n"
+                    "       calc_col [-v] run file.col\n"
+                    "       calc_col unpack file.col [out.txt]\n");
+}
+
+
+int main(int argc, char **argv) {
+    int i = 1;
+    if(i < argc && strcmp(argv[i], "-v") == 0) {
+        verbose = true;
+        i++;
+    }
+    if(i >= argc) {
+        usage();
+        return 2;
+    }
+
+    const char *cmd = argv[i++];
+    int rest = argc - i;
+    if(strcmp(cmd, "pack") == 0 && rest == 2)                 return cmd_pack(argv[i], argv[i + 1]);
+    if(strcmp(cmd, "run") == 0 && rest == 1)                  return cmd_run(argv[i]);
+    if(strcmp(cmd, "unpack") == 0 && (rest == 1 || rest == 2)) return cmd_unpack(argv[i], (rest == 2) ? argv[i + 1] : NULL);
+
+    usage();
+    return 2;
+}
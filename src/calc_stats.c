@@ -0,0 +1,247 @@
+/***********************************************************************************************************************
+ * @author Christian Reiswich
+ * @date 18 Oct. 2026
+ * @version 1.0
+ * @brief Raylib Calculator
+ * @details Statistics over a column of values (stats.h): count, sum, mean, sample standard deviation and variance,
+ *          min, max and percentiles. The input is streamed in blocks, so its size does not matter.
+ *
+ *          Text input has one value per line, ',' or '.' as decimal separator; blank lines are passed over, lines
+ *          that are not a number are counted as skipped. A column file (colfile.h) is read in place and its result
+ *          column used, leaving out the error rows; run it with calc_col first.
+ *
+ *          -p adds a percentile (0 to 100, may be given several times), the default is 50, 90 and 99. -n leaves
+ *          the percentiles out, and with them the only state that grows with the data.
+ *
+ *          Usage: calc_stats [-v] [-n | -p pct...] [file]
+ **********************************************************************************************************************/
+
+#include "colfile.h"
+#include "numfmt.h"
+#include "stats.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+
+#define TEXT_BLOCK  (1u << 20)
+#define MAX_PCTS    16
+
+static char   inBuf[TEXT_BLOCK];
+static double chunk[STATS_CHUNK];
+static bool   verbose = false;
+
+typedef struct {
+    Stats   *stats;
+    size_t   fill;
+    uint64_t skipped;
+    uint64_t bytes;
+    bool     ok;
+} Feed;
+
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+
+static void flush(Feed *feed) {
+    if(feed->fill && !stats_add(feed->stats, chunk, feed->fill)) feed->ok = false;
+    feed->fill = 0;
+}
+
+
+static void feed_value(Feed *feed, double value) {
+    chunk[feed->fill++] = value;
+    if(feed->fill == STATS_CHUNK) flush(feed);
+}
+
+
+static void feed_line(Feed *feed, const char *p, const char *end) {
+    while(p < end && (*p == ' ' || *p == '\t')) p++;
+    while(end > p && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\r')) end--;
+    if(p == end) return;
+
+    size_t used;
+    double value = numfmt_parse(p, (size_t)(end - p), &used);
+    if(used != (size_t)(end - p) || isnan(value)) {
+        feed->skipped++;
+        return;
+    }
+    feed_value(feed, value);
+}
+
+
+static bool stream_text(FILE *in, Feed *feed) {
+    size_t keep = 0;
+    bool   overlong = false;       // inside a line that did not fit into the buffer
+
+    for(;;) {
+        size_t got = fread(inBuf + keep, 1, sizeof(inBuf) - keep, in);
+        feed->bytes += got;
+        const char *p   = inBuf;
+        const char *end = inBuf + keep + got;
+
+        const char *nl;
+        while((nl = memchr(p, '\n', (size_t)(end - p))) != NULL) {
+            if(overlong) overlong = false;
+            else         feed_line(feed, p, nl);
+            p = nl + 1;
+        }
+
+        keep = (size_t)(end - p);
+        if(got == 0) {
+            if(keep && !overlong) feed_line(feed, p, end);
+            break;
+        }
+        if(keep == sizeof(inBuf)) {
+            if(!overlong) feed->skipped++;
+            overlong = true;
+            keep = 0;
+        }
+        memmove(inBuf, p, keep);
+    }
+    flush(feed);
+    return !ferror(in);
+}
+
+
+static bool is_column_file(const char *path) {
+    FILE *f = fopen(path, "rb");
+    if(!f) return false;
+    char magic[8];
+    bool yes = fread(magic, 1, sizeof(magic), f) == sizeof(magic) && memcmp(magic, COLFILE_MAGIC, sizeof(magic)) == 0;
+    fclose(f);
+    return yes;
+}
+
+
+/* Runs of rows without error go to the statistics straight from the mapping. */
+static bool stream_column(const char *path, Feed *feed) {
+    ColFile file;
+    if(!colfile_open(&file, path, false)) return false;
+
+    uint64_t row = 0;
+    while(row < file.count) {
+        uint64_t end = row;
+        while(end < file.count) {
+            if(end % 64 == 0 && end + 64 <= file.count && file.errors[end / 64] == 0) end += 64;
+            else if(!colfile_is_error(&file, end))                                     end++;
+            else                                                                       break;
+        }
+        if(end > row && !stats_add(feed->stats, file.result + row, (size_t)(end - row))) feed->ok = false;
+        if(end < file.count) {
+            feed->skipped++;
+            end++;
+        }
+        row = end;
+    }
+    feed->bytes = file.count * sizeof(double);
+    colfile_close(&file);
+    return true;
+}
+
+
+static void print_value(const char *label, double value) {
+    char text[NUMFMT_MAX_LEN];
+    numfmt_format(text, sizeof(text), value, NUMFMT_DISPLAY_DIGITS);
+    printf("%-10s %s\n", label, text);
+}
+
+
+static void usage(void) {
+    fprintf(stderr, "usage: calc_stats [-v] [-n | -p pct...] [file]\n");
+}
+
+
+int main(int argc, char **argv) {
+    double pcts[MAX_PCTS];
+    int    pctCount = 0;
+    bool   noPcts   = false;
+    const char *path = NULL;
+
+    for(int i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "-v") == 0) {
+            verbose = true;
+        } else if(strcmp(argv[i], "-n") == 0) {
+            noPcts = true;
+        } else if(strcmp(argv[i], "-p") == 0 && i + 1 < argc && pctCount < MAX_PCTS) {
+            size_t used;
+            const char *arg = argv[++i];
+            double pct = numfmt_parse(arg, strlen(arg), &used);
+            if(used != strlen(arg) || !(pct >= 0.0 && pct <= 100.0)) {
+                fprintf(stderr, "%s: not a percentile between 0 and 100\n", arg);
+                return 2;
+            }
+            pcts[pctCount++] = pct;
+        } else if(argv[i][0] == '-' && argv[i][1] != '\0') {
+            usage();
+            return 2;
+        } else if(!path) {
+            path = argv[i];
+        } else {
+            usage();
+            return 2;
+        }
+    }
+    if(noPcts && pctCount > 0) {
+        usage();
+        return 2;
+    }
+    if(pctCount == 0 && !noPcts) {
+        pcts[pctCount++] = 50.0;
+        pcts[pctCount++] = 90.0;
+        pcts[pctCount++] = 99.0;
+    }
+
+    Stats stats;
+    stats_init(&stats, !noPcts);
+    Feed feed = { &stats, 0, 0, 0, true };
+
+    double start = now_sec();
+    bool read = true;
+    if(path && is_column_file(path)) {
+        if(!stream_column(path, &feed)) {
+            fprintf(stderr, "%s: cannot map the column file\n", path);
+            return 1;
+        }
+    } else {
+        FILE *in = path ? fopen(path, "rb") : stdin;
+        if(!in) { perror(path); return 1; }
+        read = stream_text(in, &feed);
+        if(in != stdin) fclose(in);
+    }
+    double elapsed = now_sec() - start;
+    if(!read) { perror(path ? path : "stdin"); stats_free(&stats); return 1; }
+
+    printf("%-10s %llu\n", "count", (unsigned long long)stats.count);
+    if(feed.skipped) printf("%-10s %llu\n", "skipped", (unsigned long long)feed.skipped);
+    if(stats.count) {
+        double variance = stats_variance(&stats, true);
+        print_value("sum",      stats_sum(&stats));
+        print_value("mean",     stats_mean(&stats));
+        print_value("stddev",   sqrt(variance));
+        print_value("variance", variance);
+        print_value("min",      stats.min);
+        print_value("max",      stats.max);
+        for(int i = 0; i < pctCount; i++) {
+            char label[NUMFMT_MAX_LEN + 1] = "p";
+            numfmt_format(label + 1, sizeof(label) - 1, pcts[i], NUMFMT_DISPLAY_DIGITS);
+            print_value(label, stats_percentile(&stats, pcts[i] / 100.0));
+        }
+    }
+    if(!feed.ok) fprintf(stderr, "out of memory for the percentile sketch, percentiles are incomplete\n");
+
+    if(verbose) {
+        fprintf(stderr, "%llu values, %.1f MB in %.3f s (%.1f Mvalues/s, %.0f MB/s), %zu bytes of state\n",
+                (unsigned long long)(stats.count + feed.skipped), (double)feed.bytes * 1e-6, elapsed,
+                elapsed > 0 ? (double)stats.count / elapsed * 1e-6 : 0.0,
+                elapsed > 0 ? (double)feed.bytes / elapsed * 1e-6 : 0.0, stats_memory(&stats));
+    }
+    stats_free(&stats);
+    return feed.ok ? 0 : 1;
+}
@@ -0,0 +1,134 @@
+/***********************************************************************************************************************
+ * @author Christian Reiswich
+ * @date 18 Oct. 2026
+ * @version 1.0
+ * @brief Raylib Calculator
+ * @details Reads a history tape (history.h), for audits and searches. The tape is opened read-only and never
+ *          written, so a tape the auditor may only read works as well.
+ *
+ *            list:   entries from `first` on (default: all), one line each: index, local time, calculation
+ *            value:  entries with the value as result or operand, within an optional tolerance
+ *            prefix: entries whose displayed result starts with the text, e.g. "12,5" or "-3"
+ *
+ *          Usage: calc_tape [-v] file list [first [count]] | value x [tolerance] | prefix text
+ **********************************************************************************************************************/
+
+#include "history.h"
+#include "numfmt.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+
+static bool verbose = false;
+
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+
+static void print_entry(const History *h, uint64_t index) {
+    const HistoryEntry *e = &h->entries[index];
+    char text[3 * HISTORY_TEXT_LEN + 16];
+    char stamp[32];
+    time_t t = (time_t)e->time;
+    struct tm *tm = localtime(&t);
+    if(!tm || strftime(stamp, sizeof(stamp), "%Y-%m-%d %H:%M:%S", tm) == 0) strcpy(stamp, "-");
+
+    history_format(e, text, sizeof(text));
+    printf("%llu\t%s\t%s%s\n", (unsigned long long)index, stamp, text, (e->flags & HISTORY_DECIMAL) ? "\t(decimal)" : "");
+}
+
+
+static int cmd_list(const History *h, int argc, char **argv) {
+    uint64_t count = history_count(h);
+    uint64_t first = (argc > 0) ? strtoull(argv[0], NULL, 10) : 0;
+    uint64_t n     = (argc > 1) ? strtoull(argv[1], NULL, 10) : count;
+
+    uint64_t shown = 0;
+    for(uint64_t i = first; i < count && shown < n; i++) {
+        if(h->entries[i].flags & HISTORY_PART) continue;
+        print_entry(h, i);
+        shown++;
+    }
+    return 0;
+}
+
+
+static int cmd_value(const History *h, int argc, char **argv) {
+    double value     = numfmt_parse(argv[0], strlen(argv[0]), NULL);
+    double tolerance = (argc > 1) ? numfmt_parse(argv[1], strlen(argv[1]), NULL) : 0.0;
+
+    uint64_t matches = 0;
+    for(int64_t i = history_find_value(h, value, tolerance, 0); i >= 0;
+        i = history_find_value(h, value, tolerance, (uint64_t)i + 1)) {
+        print_entry(h, (uint64_t)i);
+        matches++;
+    }
+    return matches ? 0 : 1;
+}
+
+
+static int cmd_prefix(const History *h, char **argv) {
+    uint64_t matches = 0;
+    for(int64_t i = history_find_prefix(h, argv[0], 0); i >= 0; i = history_find_prefix(h, argv[0], (uint64_t)i + 1)) {
+        print_entry(h, (uint64_t)i);
+        matches++;
+    }
+    return matches ? 0 : 1;
+}
+
+
+static void usage(void) {
+    fprintf(stderr, "usage: calc_tape [-v] file list [first [count]]\n"
+                    "       calc_tape [-v] file value x [tolerance]\n"
+                    "       calc_tape [-v] file prefix text\n");
+}
+
+
+int main(int argc, char **argv) {
+    int i = 1;
+    if(i < argc && strcmp(argv[i], "-v") == 0) {
+        verbose = true;
+        i++;
+    }
+    if(argc - i < 2) {
+        usage();
+        return 2;
+    }
+
+    const char *path = argv[i++];
+    const char *cmd  = argv[i++];
+    int rest = argc - i;
+
+    // tells a missing or unreadable file apart from one that is no tape
+    FILE *probe = fopen(path, "rb");
+    if(!probe) { perror(path); return 1; }
+    fclose(probe);
+
+    double start = now_sec();
+    History h;
+    if(!history_open_readonly(&h, path)) {
+        fprintf(stderr, "%s: not a history tape\n", path);
+        return 1;
+    }
+    double opened = now_sec();
+
+    int status = 2;
+    if(strcmp(cmd, "list") == 0 && rest <= 2)                    status = cmd_list(&h, rest, argv + i);
+    else if(strcmp(cmd, "value") == 0 && (rest == 1 || rest == 2)) status = cmd_value(&h, rest, argv + i);
+    else if(strcmp(cmd, "prefix") == 0 && rest == 1)               status = cmd_prefix(&h, argv + i);
+    else                                                           usage();
+
+    if(verbose) {
+        fprintf(stderr, "%llu entries, opened in %.3f ms, command took %.3f ms\n",
+                (unsigned long long)history_count(&h), (opened - start) * 1e3, (now_sec() - opened) * 1e3);
+    }
+    history_close(&h);
+    return status;
+}
@@ -0,0 +1,449 @@
+/***********************************************************************************************************************
+ * @author Christian Reiswich
+ * @date 18 Oct. 2026
+ * @version 1.0
+ * @brief Raylib Calculator
+ * @details Evaluation daemon on a Unix domain socket, so tools can calculate without starting a process per value.
+ *
+ *          The protocol is one request per line and one reply line per request, in order. A client may send any
+ *          number of requests before it reads (pipelining):
+ *
+ *            k keys    feeds the keys to the connection's calculator, replies with its display ("k 12+3=" -> "15")
+ *            e expr    evaluates an expression without names ("e (1 + 2) * 3" -> "9"), or replies "Error"
+ *            stats     requests served, open connections and latency percentiles in microseconds
+ *            quit      closes the connection once the replies before it are written
+ *
+ *          Every connection keeps its own calculator for as long as it is open, so "k 12+" and a later "k 3="
+ *          continue one calculation. The calculators are sessions of one sessions.h table (double backend), 18
+ *          bytes each instead of a Calc. Unknown requests reply "Error".
+ *
+ *          A single thread serves all connections with epoll. Each wakeup reads what a client has sent, answers
+ *          every complete line in it into the connection's output buffer, and writes the replies with one send().
+ *          A client whose replies pile up beyond CALCD_OUT_LIMIT is not read from until it catches up.
+ *          The latency of a request runs from the read that brought it to the send() of its reply; the values
+ *          go into the percentile sketch of stats.h.
+ *
+ *          Usage: calcd [-v] [socket]      (default calcd.sock, removed again on SIGINT or SIGTERM)
+ **********************************************************************************************************************/
+
+#define _GNU_SOURCE     // accept4()
+
+#include "calc.h"
+#include "expr.h"
+#include "sessions.h"
+#include "stats.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+
+#define CALCD_BLOCK     (64u << 10)     // input buffer per connection, also the longest request
+#define CALCD_OUT_LIMIT (1u << 20)      // pending reply bytes beyond which a client is not read from
+#define CALCD_EVENTS    64
+
+typedef struct {
+    int      fd;
+    uint32_t events;                    // what epoll currently watches for
+    bool     closing;                   // "quit", end of input or an error: no more requests
+    bool     shut;                      // replies all sent; input is dropped until the client closes
+    uint32_t session;
+
+    char    *in;
+    size_t   inLen;
+    char    *out;
+    size_t   outHead;                   // bytes before this have been sent
+    size_t   outLen;
+    size_t   outCap;
+} Conn;
+
+typedef struct {
+    int      epfd;
+    int      listenFd;
+    int      spareFd;                   // held open so a client can still be accepted and refused at the fd limit
+    int      open;
+    uint64_t accepted;
+    uint64_t requests;
+    Sessions sessions;
+
+    Stats    latency;                   // microseconds
+    double   chunk[STATS_CHUNK];        // latencies not yet in `latency`
+    size_t   fill;
+} Server;
+
+static volatile sig_atomic_t stopping = 0;
+static bool verbose = false;
+
+
+static double now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e6 + (double)ts.tv_nsec * 1e-3;
+}
+
+
+static void on_signal(int sig) {
+    (void)sig;
+    stopping = 1;
+}
+
+
+static void latency_flush(Server *s) {
+    if(s->fill && !stats_add(&s->latency, s->chunk, s->fill) && verbose) fprintf(stderr, "stats: out of memory\n");
+    s->fill = 0;
+}
+
+
+/* `count` requests that took `us` each. */
+static void latency_add(Server *s, double us, size_t count) {
+    for(size_t i = 0; i < count; i++) {
+        s->chunk[s->fill++] = us;
+        if(s->fill == STATS_CHUNK) latency_flush(s);
+    }
+}
+
+
+static bool out_reserve(Conn *c, size_t n) {
+    if(c->outLen + n <= c->outCap) return true;
+    if(c->outHead > 0) {
+        memmove(c->out, c->out + c->outHead, c->outLen - c->outHead);
+        c->outLen -= c->outHead;
+        c->outHead = 0;
+        if(c->outLen + n <= c->outCap) return true;
+    }
+
+    size_t cap = c->outCap ? c->outCap : 4096;
+    while(cap < c->outLen + n) cap *= 2;
+    char *out = realloc(c->out, cap);
+    if(!out) return false;
+    c->out    = out;
+    c->outCap = cap;
+    return true;
+}
+
+
+static void out_line(Conn *c, const char *text) {
+    size_t strLength = strlen(text);
+    if(!out_reserve(c, strLength + 1)) {
+        c->closing = true;
+        return;
+    }
+    memcpy(c->out + c->outLen, text, strLength);
+    c->outLen += strLength;
+    c->out[c->outLen++] = '\n';
+}
+
+
+static void reply_stats(Server *s, Conn *c) {
+    latency_flush(s);
+    const Stats *l = &s->latency;
+    char text[256];
+    if(l->count == 0) {
+        snprintf(text, sizeof(text), "requests %llu connections %d", (unsigned long long)s->requests, s->open);
+    } else {
+        snprintf(text, sizeof(text), "requests %llu connections %d p50 %.1f p90 %.1f p99 %.1f p99.9 %.1f max %.1f us",
+                 (unsigned long long)s->requests, s->open, stats_percentile(l, 0.5), stats_percentile(l, 0.9),
+                 stats_percentile(l, 0.99), stats_percentile(l, 0.999), l->max);
+    }
+    out_line(c, text);
+}
+
+
+static void request(Server *s, Conn *c, char *line) {
+    char text[64];
+    s->requests++;
+
+    if(line[0] == 'k' && (line[1] == ' ' || line[1] == '\0')) {
+        for(const char *p = line + 1; *p; p++) {
+            if(*p != ' ' && *p != '\t') sessions_press(&s->sessions, c->session, *p);
+        }
+        sessions_display(&s->sessions, c->session, text, sizeof(text));
+        out_line(c, text);
+    } else if(line[0] == 'e' && line[1] == ' ') {
+        ExprProgram prog;
+        double value = NAN;
+        if(expr_compile(&prog, line + 2) && prog.varCount == 0) value = expr_run(&prog, NULL);
+        if(isnan(value)) {
+            out_line(c, "Error");
+        } else {
+            format_number(text, sizeof(text), value);
+            out_line(c, text);
+        }
+    } else if(strcmp(line, "stats") == 0) {
+        reply_stats(s, c);
+    } else if(strcmp(line, "quit") == 0) {
+        c->closing = true;
+    } else {
+        out_line(c, "Error");
+    }
+}
+
+
+/* Answers the complete lines in the input buffer; returns how many. A partial last line stays for the next read. */
+static size_t run_lines(Server *s, Conn *c) {
+    size_t count = 0;
+    char *line = c->in;
+    char *end  = c->in + c->inLen;
+
+    char *nl;
+    while(!c->closing && (nl = memchr(line, '\n', (size_t)(end - line))) != NULL) {
+        if(nl > line && nl[-1] == '\r') nl[-1] = '\0';
+        *nl = '\0';
+        request(s, c, line);
+        count++;
+        line = nl + 1;
+    }
+
+    c->inLen = c->closing ? 0 : (size_t)(end - line);
+    memmove(c->in, line, c->inLen);
+    if(c->inLen == CALCD_BLOCK) {
+        out_line(c, "Error line too long");
+        c->closing = true;
+        c->inLen   = 0;
+    }
+    return count;
+}
+
+
+static void conn_close(Server *s, Conn *c) {
+    epoll_ctl(s->epfd, EPOLL_CTL_DEL, c->fd, NULL);
+    close(c->fd);
+    sessions_close(&s->sessions, c->session);
+    free(c->in);
+    free(c->out);
+    free(c);
+    s->open--;
+}
+
+
+/* Sends what is pending. Returns false when the connection is gone. */
+static bool conn_flush(Server *s, Conn *c) {
+    while(c->outHead < c->outLen) {
+        ssize_t n = send(c->fd, c->out + c->outHead, c->outLen - c->outHead, MSG_NOSIGNAL);
+        if(n > 0) {
+            c->outHead += (size_t)n;
+            continue;
+        }
+        if(n < 0 && errno == EINTR) continue;
+        if(n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        conn_close(s, c);
+        return false;
+    }
+    if(c->outHead == c->outLen) c->outHead = c->outLen = 0;
+
+    // closing at once would reset the connection if the client is still sending, and it might lose the replies
+    if(c->closing && c->outLen == 0 && !c->shut) {
+        shutdown(c->fd, SHUT_WR);
+        c->shut = true;
+    }
+
+    uint32_t events = 0;
+    if(c->shut || (!c->closing && c->outLen - c->outHead < CALCD_OUT_LIMIT)) events |= EPOLLIN;
+    if(c->outLen > c->outHead)                                  events |= EPOLLOUT;
+    if(events != c->events) {
+        struct epoll_event ev = { .events = events, .data.ptr = c };
+        epoll_ctl(s->epfd, EPOLL_CTL_MOD, c->fd, &ev);
+        c->events = events;
+    }
+    return true;
+}
+
+
+static void conn_read(Server *s, Conn *c) {
+    if(c->shut) {
+        ssize_t n = recv(c->fd, c->in, CALCD_BLOCK, 0);
+        if(n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) conn_close(s, c);
+        return;
+    }
+
+    ssize_t n = recv(c->fd, c->in + c->inLen, CALCD_BLOCK - c->inLen, 0);
+    if(n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) return;
+    if(n <= 0) {
+        // end of input: whatever was sent is answered, a last line without '\n' too
+        if(n < 0) {
+            conn_close(s, c);
+            return;
+        }
+        if(c->inLen > 0 && c->inLen < CALCD_BLOCK) c->in[c->inLen++] = '\n';
+        run_lines(s, c);
+        c->closing = true;
+        conn_flush(s, c);
+        return;
+    }
+
+    double start = now_us();
+    c->inLen += (size_t)n;
+    size_t count = run_lines(s, c);
+    conn_flush(s, c);
+    if(count) latency_add(s, now_us() - start, count);
+}
+
+
+static void accept_all(Server *s) {
+    for(;;) {
+        int fd = accept4(s->listenFd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if(fd < 0) {
+            if(errno == EINTR) continue;
+            if((errno == EMFILE || errno == ENFILE) && s->spareFd >= 0) {
+                // the pending client would keep the listening socket readable forever, so take it and let it go
+                close(s->spareFd);
+                fd = accept4(s->listenFd, NULL, NULL, SOCK_CLOEXEC);
+                if(fd >= 0) close(fd);
+                s->spareFd = open("/dev/null", O_RDONLY | O_CLOEXEC);
+                if(verbose) fprintf(stderr, "accept: out of file descriptors, refused a client\n");
+                if(fd >= 0) continue;
+                return;
+            }
+            if(errno != EAGAIN && errno != EWOULDBLOCK && verbose) perror("accept");
+            return;
+        }
+
+        Conn *c = calloc(1, sizeof(Conn));
+        if(c) c->in = malloc(CALCD_BLOCK);
+        int64_t session = (c && c->in) ? sessions_open(&s->sessions) : -1;
+        if(session < 0) {
+            if(c) free(c->in);
+            free(c);
+            close(fd);
+            continue;
+        }
+        c->fd      = fd;
+        c->events  = EPOLLIN;
+        c->session = (uint32_t)session;
+
+        struct epoll_event ev = { .events = EPOLLIN, .data.ptr = c };
+        if(epoll_ctl(s->epfd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+            sessions_close(&s->sessions, c->session);
+            free(c->in);
+            free(c);
+            close(fd);
+            continue;
+        }
+        s->open++;
+        s->accepted++;
+    }
+}
+
+
+/* Binds `path`, replacing a socket file that nobody listens on any more. */
+static int listen_on(const char *path) {
+    struct sockaddr_un addr = { .sun_family = AF_UNIX };
+    if(strlen(path) >= sizeof(addr.sun_path)) {
+        fprintf(stderr, "%s: path too long\n", path);
+        return -1;
+    }
+    strcpy(addr.sun_path, path);
+
+    struct stat st;
+    if(stat(path, &st) == 0 && S_ISSOCK(st.st_mode)) {
+        int probe = socket(AF_UNIX, SOCK_STREAM, 0);
+        bool live = probe >= 0 && connect(probe, (struct sockaddr *)&addr, sizeof(addr)) == 0;
+        if(probe >= 0) close(probe);
+        if(live) {
+            fprintf(stderr, "%s: another daemon is listening\n", path);
+            return -1;
+        }
+        unlink(path);
+    }
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if(fd < 0 || bind(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 || listen(fd, SOMAXCONN) != 0) {
+        perror(path);
+        if(fd >= 0) close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+
+static void usage(void) {
+    fprintf(stderr, "usage: calcd [-v] [socket]\n"
+                    "  per line: \"k keys\", \"e expression\", \"stats\" or \"quit\"\n");
+}
+
+
+int main(int argc, char **argv) {
+    const char *path = "calcd.sock";
+    for(int i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "-v") == 0) {
+            verbose = true;
+        } else if(argv[i][0] == '-') {
+            usage();
+            return 2;
+        } else {
+            path = argv[i];
+        }
+    }
+
+    static Server server;
+    Server *s = &server;
+    stats_init(&s->latency, true);
+    sessions_init(&s->sessions);
+    s->spareFd  = open("/dev/null", O_RDONLY | O_CLOEXEC);
+    s->listenFd = listen_on(path);
+    if(s->listenFd < 0) return 1;
+
+    s->epfd = epoll_create1(EPOLL_CLOEXEC);
+    struct epoll_event ev = { .events = EPOLLIN, .data.ptr = NULL };
+    if(s->epfd < 0 || epoll_ctl(s->epfd, EPOLL_CTL_ADD, s->listenFd, &ev) != 0) {
+        perror("epoll");
+        unlink(path);
+        return 1;
+    }
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = on_signal;
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+    if(verbose) fprintf(stderr, "listening on %s\n", path);
+
+    struct epoll_event events[CALCD_EVENTS];
+    while(!stopping) {
+        int n = epoll_wait(s->epfd, events, CALCD_EVENTS, -1);
+        if(n < 0) {
+            if(errno == EINTR) continue;
+            perror("epoll_wait");
+            break;
+        }
+        for(int i = 0; i < n; i++) {
+            Conn *c = events[i].data.ptr;
+            if(!c) {
+                accept_all(s);
+                continue;
+            }
+            if(events[i].events & EPOLLIN)                       conn_read(s, c);
+            else if(events[i].events & EPOLLOUT)                 conn_flush(s, c);
+            else if(events[i].events & (EPOLLERR | EPOLLHUP))    conn_close(s, c);
+        }
+    }
+
+    if(verbose) {
+        latency_flush(s);
+        fprintf(stderr, "%llu connections, %llu requests", (unsigned long long)s->accepted,
+                (unsigned long long)s->requests);
+        if(s->latency.count) {
+            fprintf(stderr, ", latency p50 %.1f p99 %.1f max %.1f us", stats_percentile(&s->latency, 0.5),
+                    stats_percentile(&s->latency, 0.99), s->latency.max);
+        }
+        fputc('\n', stderr);
+    }
+    close(s->listenFd);
+    close(s->epfd);
+    if(s->spareFd >= 0) close(s->spareFd);
+    unlink(path);
+    stats_free(&s->latency);
+    sessions_free(&s->sessions);
+    return 0;
+}
@@ -0,0 +1,152 @@
+/***********************************************************************************************************************
+ * @author Christian Reiswich
+ * @date 18 Oct. 2026
+ * @version 1.0
+ * @brief Raylib Calculator
+ * @details
+ **********************************************************************************************************************/
+
+#include "colfile.h"
+#include "simd.h"
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define COMPUTE_BLOCK 4096      // rows per eval_batch_ops() call, a multiple of 64 so blocks own whole bitmap words
+
+
+static uint64_t align_up(uint64_t v) {
+    return (v + COLFILE_ALIGN - 1) & ~(uint64_t)(COLFILE_ALIGN - 1);
+}
+
+
+static void layout(ColHeader *h, uint64_t count) {
+    memset(h, 0, sizeof(*h));
+    memcpy(h->magic, COLFILE_MAGIC, sizeof(h->magic));
+    h->version    = COLFILE_VERSION;
+    h->headerSize = sizeof(ColHeader);
+    h->count      = count;
+    h->leftOff    = align_up(sizeof(ColHeader));
+    h->rightOff   = align_up(h->leftOff   + count * sizeof(double));
+    h->opsOff     = align_up(h->rightOff  + count * sizeof(double));
+    h->resultOff  = align_up(h->opsOff    + count);
+    h->errorOff   = align_up(h->resultOff + count * sizeof(double));
+}
+
+
+static uint64_t file_size(const ColHeader *h) {
+    return h->errorOff + (h->count + 63) / 64 * sizeof(uint64_t);
+}
+
+
+static void bind_columns(ColFile *file, const ColHeader *h) {
+    char *base   = file->map;
+    file->count  = h->count;
+    file->left   = (double *)(base + h->leftOff);
+    file->right  = (double *)(base + h->rightOff);
+    file->ops    = base + h->opsOff;
+    file->result = (double *)(base + h->resultOff);
+    file->errors = (uint64_t *)(base + h->errorOff);
+}
+
+
+static bool map_file(ColFile *file, int fd, size_t size, bool writable) {
+    int prot = writable ? (PROT_READ | PROT_WRITE) : PROT_READ;
+    void *map = mmap(NULL, size ? size : 1, prot, MAP_SHARED, fd, 0);
+    if(map == MAP_FAILED) return false;
+
+    madvise(map, size, MADV_SEQUENTIAL);
+    file->map      = map;
+    file->size     = size;
+    file->fd       = fd;
+    file->writable = writable;
+    return true;
+}
+
+
+/* Creates the file at its final size with every column zeroed (result 0, no errors). */
+bool colfile_create(ColFile *file, const char *path, uint64_t count) {
+    ColHeader h;
+    layout(&h, count);
+
+    int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if(fd < 0) return false;
+    if(ftruncate(fd, (off_t)file_size(&h)) != 0 || !map_file(file, fd, (size_t)file_size(&h), true)) {
+        close(fd);
+        return false;
+    }
+
+    memcpy(file->map, &h, sizeof(h));
+    bind_columns(file, &h);
+    return true;
+}
+
+
+bool colfile_open(ColFile *file, const char *path, bool writable) {
+    int fd = open(path, writable ? O_RDWR : O_RDONLY);
+    if(fd < 0) return false;
+
+    struct stat st;
+    if(fstat(fd, &st) != 0 || (uint64_t)st.st_size < sizeof(ColHeader)) {
+        close(fd);
+        return false;
+    }
+    if(!map_file(file, fd, (size_t)st.st_size, writable)) {
+        close(fd);
+        return false;
+    }
+
+    ColHeader h, expect;
+    memcpy(&h, file->map, sizeof(h));
+    layout(&expect, h.count);
+    if(memcmp(&h, &expect, sizeof(h)) != 0 || h.count > (uint64_t)st.st_size
+       || file_size(&h) > (uint64_t)st.st_size) {
+        colfile_close(file);
+        return false;
+    }
+
+    bind_columns(file, &h);
+    return true;
+}
+
+
+bool colfile_close(ColFile *file) {
+    bool ok = true;
+    if(file->map) {
+        if(file->writable && msync(file->map, file->size, MS_SYNC) != 0) ok = false;
+        munmap(file->map, file->size ? file->size : 1);
+    }
+    if(file->fd >= 0 && close(file->fd) != 0) ok = false;
+    file->map = NULL;
+    file->fd  = -1;
+    return ok;
+}
+
+
+/* Fills result and errors from left, ops and right in place. Returns the number of errors. */
+uint64_t colfile_compute(ColFile *file) {
+    uint64_t errorCount = 0;
+
+    for(uint64_t start = 0; start < file->count; start += COMPUTE_BLOCK) {
+        uint64_t n = file->count - start;
+        if(n > COMPUTE_BLOCK) n = COMPUTE_BLOCK;
+
+        double *res = file->result + start;
+        eval_batch_ops(file->left + start, file->right + start, file->ops + start, res, (size_t)n);
+
+        for(uint64_t w = 0; w < (n + 63) / 64; w++) {
+            uint64_t bits = 0;
+            uint64_t end  = (n - w * 64 < 64) ? n - w * 64 : 64;
+            for(uint64_t b = 0; b < end; b++) {
+                double v = res[w * 64 + b];
+                bits |= (uint64_t)(v != v) << b;
+            }
+            file->errors[start / 64 + w] = bits;
+            errorCount += (uint64_t)__builtin_popcountll(bits);
+        }
+    }
+    return errorCount;
+}
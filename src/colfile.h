@@ -0,0 +1,65 @@
+/***********************************************************************************************************************
+ * @author Christian Reiswich
+ * @date 18 Oct. 2026
+ * @version 1.0
+ * @brief Raylib Calculator
+ * @details Columnar binary file for bulk calculations, used in place through mmap. Layout, little endian:
+ *
+ *            ColHeader (64 bytes)
+ *            double   left  [count]
+ *            double   right [count]
+ *            char     ops   [count]      '+', '-', '*', '/'
+ *            double   result[count]
+ *            uint64_t errors[(count + 63) / 64]   bit i set: result[i] is an error (NaN)
+ *
+ *          Every column starts on a 64 byte boundary, so the columns can go straight into eval_batch_ops().
+ **********************************************************************************************************************/
+
+#ifndef RAYLIBPROJEKT_COLFILE_H
+#define RAYLIBPROJEKT_COLFILE_H
+
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define COLFILE_MAGIC   "CALCCOL1"
+#define COLFILE_VERSION 1
+#define COLFILE_ALIGN   64
+
+typedef struct {
+    char     magic[8];
+    uint32_t version;
+    uint32_t headerSize;
+    uint64_t count;
+    uint64_t leftOff;
+    uint64_t rightOff;
+    uint64_t opsOff;
+    uint64_t resultOff;
+    uint64_t errorOff;
+} ColHeader;
+
+typedef struct {
+    void     *map;
+    size_t    size;
+    int       fd;
+    bool      writable;
+    uint64_t  count;
+    double   *left;
+    double   *right;
+    char     *ops;
+    double   *result;
+    uint64_t *errors;
+} ColFile;
+
+bool     colfile_create (ColFile *file, const char *path, uint64_t count);
+bool     colfile_open   (ColFile *file, const char *path, bool writable);
+bool     colfile_close  (ColFile *file);
+uint64_t colfile_compute(ColFile *file);
+
+static inline bool colfile_is_error(const ColFile *file, uint64_t row) {
+    return (file->errors[row / 64] >> (row % 64)) & 1u;
+}
+
+
+#endif //RAYLIBPROJEKT_COLFILE_H
@@ -0,0 +1,219 @@
+/***********************************************************************************************************************
+ * @author Christian Reiswich
+ * @date 18 Oct. 2026
+ * @version 1.0
+ * @brief Raylib Calculator
+ * @details
+ **********************************************************************************************************************/
+
+#include "curve.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// every pass at most doubles the points, and every interval can take one break on top
+#define CURVE_SCRATCH (2 * (CURVE_TILE_SAMPLES << CURVE_MAX_DEPTH) + 2)
+
+
+void curve_init(Curve *curve) {
+    memset(curve, 0, sizeof(*curve));
+}
+
+
+void curve_free(Curve *curve) {
+    jit_free(&curve->jit);
+    for(int i = 0; i < CURVE_CACHE_TILES; i++) free(curve->tiles[i].points);
+    free(curve->xs);
+    free(curve->ys);
+    free(curve->split);
+    free(curve->work[0]);
+    free(curve->work[1]);
+    memset(curve, 0, sizeof(*curve));
+}
+
+
+/* Compiles `src` as a function of x and drops every cached tile. On failure curve->prog.error and errorPos tell
+ * what is wrong, and curve_tile() returns NULL until a formula compiles. */
+bool curve_set(Curve *curve, const char *src) {
+    for(int i = 0; i < CURVE_CACHE_TILES; i++) curve->tiles[i].stamp = 0;
+    jit_free(&curve->jit);
+    curve->valid = false;
+
+    if(!expr_compile(&curve->prog, src)) return false;
+    if(curve->prog.varCount > 1 || (curve->prog.varCount == 1 && strcmp(curve->prog.vars[0], "x") != 0)) {
+        curve->prog.error    = "only x may vary";
+        curve->prog.errorPos = (int)(strstr(src, curve->prog.vars[curve->prog.varCount - 1]) - src);
+        return false;
+    }
+    jit_compile(&curve->jit, &curve->prog);     // without it jit_run_batch() takes the VM
+    curve->valid = true;
+    return true;
+}
+
+
+/* The level whose tiles are 128 to 256 pixels wide, so the even samples are at most a pixel apart. */
+int curve_level_for(double pixelsPerUnit) {
+    if(!(pixelsPerUnit > 0.0) || !isfinite(pixelsPerUnit)) return CURVE_MAX_LEVEL;
+    double level = floor(log2(256.0 / pixelsPerUnit));
+    if(level < CURVE_MIN_LEVEL) return CURVE_MIN_LEVEL;
+    if(level > CURVE_MAX_LEVEL) return CURVE_MAX_LEVEL;
+    return (int)level;
+}
+
+
+static bool reserve_scratch(Curve *curve) {
+    if(curve->xs) return true;
+    curve->xs      = malloc(CURVE_SCRATCH * sizeof(double));
+    curve->ys      = malloc(CURVE_SCRATCH * sizeof(double));
+    curve->split   = malloc(CURVE_SCRATCH * sizeof(bool));
+    curve->work[0] = malloc(CURVE_SCRATCH * sizeof(CurvePoint));
+    curve->work[1] = malloc(CURVE_SCRATCH * sizeof(CurvePoint));
+    if(curve->xs && curve->ys && curve->split && curve->work[0] && curve->work[1]) return true;
+
+    free(curve->xs);
+    free(curve->ys);
+    free(curve->split);
+    free(curve->work[0]);
+    free(curve->work[1]);
+    curve->xs = curve->ys = NULL;
+    curve->split = NULL;
+    curve->work[0] = curve->work[1] = NULL;
+    return false;
+}
+
+
+static void evaluate(Curve *curve, int count) {
+    jit_run_batch(&curve->jit, &curve->prog, curve->xs, 1, curve->ys, (size_t)count);
+    curve->evaluated += (unsigned long long)count;
+}
+
+
+/* Marks the intervals next to a point that strays from the chord of its neighbours by more than `tol`, or where
+ * the curve turns finite or non-finite. Returns how many were marked. */
+static int mark_splits(const CurvePoint *p, int n, double tol, bool *split) {
+    memset(split, 0, (size_t)n * sizeof(bool));
+    for(int k = 1; k + 1 < n; k++) {
+        bool fa = isfinite(p[k - 1].y), fb = isfinite(p[k].y), fc = isfinite(p[k + 1].y);
+        bool bend = false;
+        if(fa != fb || fb != fc) {
+            bend = true;
+        } else if(fb) {
+            double t = (p[k].x - p[k - 1].x) / (p[k + 1].x - p[k - 1].x);
+            double chord = p[k - 1].y + (p[k + 1].y - p[k - 1].y) * t;
+            bend = fabs(p[k].y - chord) > tol;
+        }
+        if(bend) split[k - 1] = split[k] = true;
+    }
+
+    int marked = 0;
+    for(int k = 0; k + 1 < n; k++) marked += split[k];
+    return marked;
+}
+
+
+/* Copies p to out with a NaN point in every interval that still jumps against the slope on both sides after the
+ * last pass: the curve goes off to infinity there and comes back from the other side. */
+static int insert_breaks(const CurvePoint *p, int n, CurvePoint *out) {
+    int count = 0;
+    for(int k = 0; k < n; k++) {
+        out[count++] = p[k];
+        if(k < 1 || k + 2 >= n) continue;
+
+        double d0 = p[k].y - p[k - 1].y;
+        double d1 = p[k + 1].y - p[k].y;
+        double d2 = p[k + 2].y - p[k + 1].y;
+        if(d0 * d1 < 0.0 && d1 * d2 < 0.0 && fabs(d1) > fabs(d0) + fabs(d2)) {
+            out[count++] = (CurvePoint){ 0.5 * (p[k].x + p[k + 1].x), NAN };
+        }
+    }
+    return count;
+}
+
+
+static bool fill_tile(Curve *curve, CurveTile *tile) {
+    if(!reserve_scratch(curve)) return false;
+
+    double width = ldexp(1.0, tile->level);
+    double x0    = (double)tile->index * width;
+    double step  = width / CURVE_TILE_SAMPLES;
+
+    int n = CURVE_TILE_SAMPLES + 1;
+    for(int i = 0; i < n; i++) curve->xs[i] = x0 + step * i;
+    evaluate(curve, n);
+
+    CurvePoint *cur  = curve->work[0];
+    CurvePoint *next = curve->work[1];
+    double lo = INFINITY, hi = -INFINITY;
+    for(int i = 0; i < n; i++) {
+        cur[i] = (CurvePoint){ curve->xs[i], curve->ys[i] };
+        if(isfinite(curve->ys[i])) {
+            if(curve->ys[i] < lo) lo = curve->ys[i];
+            if(curve->ys[i] > hi) hi = curve->ys[i];
+        }
+    }
+    double tol = (hi > lo) ? (hi - lo) / 1024.0 : 0.0;
+
+    for(int depth = 0; depth < CURVE_MAX_DEPTH; depth++) {
+        if(mark_splits(cur, n, tol, curve->split) == 0) break;
+
+        int mids = 0;
+        for(int k = 0; k + 1 < n; k++) {
+            if(curve->split[k]) curve->xs[mids++] = 0.5 * (cur[k].x + cur[k + 1].x);
+        }
+        evaluate(curve, mids);
+
+        int out = 0, m = 0;
+        for(int k = 0; k < n; k++) {
+            next[out++] = cur[k];
+            if(k + 1 < n && curve->split[k]) {
+                next[out++] = (CurvePoint){ curve->xs[m], curve->ys[m] };
+                m++;
+            }
+        }
+        CurvePoint *swap = cur;
+        cur  = next;
+        next = swap;
+        n    = out;
+    }
+    n = insert_breaks(cur, n, next);
+
+    if(tile->cap < n) {
+        CurvePoint *points = realloc(tile->points, (size_t)n * sizeof(CurvePoint));
+        if(!points) return false;
+        tile->points = points;
+        tile->cap    = n;
+    }
+    memcpy(tile->points, next, (size_t)n * sizeof(CurvePoint));
+    tile->count = n;
+    return true;
+}
+
+
+/* The tile at `index` of `level`, from the cache or computed now. NULL without a formula or memory. */
+const CurveTile *curve_tile(Curve *curve, int level, int64_t index) {
+    if(!curve->valid) return NULL;
+    if(++curve->clock == 0) {
+        for(int i = 0; i < CURVE_CACHE_TILES; i++) curve->tiles[i].stamp = 0;
+        curve->clock = 1;
+    }
+
+    CurveTile *victim = &curve->tiles[0];
+    for(int i = 0; i < CURVE_CACHE_TILES; i++) {
+        CurveTile *tile = &curve->tiles[i];
+        if(tile->stamp && tile->level == level && tile->index == index) {
+            tile->stamp = curve->clock;
+            curve->hits++;
+            return tile;
+        }
+        if(tile->stamp < victim->stamp) victim = tile;
+    }
+
+    curve->misses++;
+    victim->stamp = 0;
+    victim->level = level;
+    victim->index = index;
+    if(!fill_tile(curve, victim)) return NULL;
+    victim->stamp = curve->clock;
+    return victim;
+}
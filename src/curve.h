@@ -0,0 +1,71 @@
+/***********************************************************************************************************************
+ * @author Christian Reiswich
+ * @date 18 Oct. 2026
+ * @version 1.0
+ * @brief Raylib Calculator
+ * @details Samples of y = f(x) for the plot view. The formula is compiled once (expr.h, jit.h) and evaluated in
+ *          batches. Samples live in tiles: at level L a tile spans [index, index + 1) * 2^L on the x axis and
+ *          starts with CURVE_TILE_SAMPLES even steps. Where the curve bends, or turns non-finite, the intervals
+ *          are halved in up to CURVE_MAX_DEPTH passes, each pass evaluating all its new midpoints in one batch.
+ *          A jump that survives the last pass (a pole) gets a NaN sample so the curve is not drawn across it.
+ *
+ *          Tiles stay in a cache of CURVE_CACHE_TILES and are evicted least recently used first, so panning only
+ *          computes the tiles that come into view, and zooming back finds the previous level still there.
+ **********************************************************************************************************************/
+
+#ifndef RAYLIBPROJEKT_CURVE_H
+#define RAYLIBPROJEKT_CURVE_H
+
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "expr.h"
+#include "jit.h"
+
+#define CURVE_TILE_SAMPLES 256
+#define CURVE_MAX_DEPTH    4
+#define CURVE_CACHE_TILES  64
+#define CURVE_MIN_LEVEL    (-40)
+#define CURVE_MAX_LEVEL    40
+
+typedef struct {
+    double x;
+    double y;                       // NaN where the curve is broken
+} CurvePoint;
+
+typedef struct {
+    int         level;
+    int64_t     index;
+    uint32_t    stamp;              // last use, 0 for a free slot
+    CurvePoint *points;             // sorted by x, both tile ends included
+    int         count;
+    int         cap;
+} CurveTile;
+
+typedef struct {
+    ExprProgram prog;
+    JitProgram  jit;
+    bool        valid;
+
+    CurveTile   tiles[CURVE_CACHE_TILES];
+    uint32_t    clock;
+
+    double     *xs;                 // scratch for building a tile, allocated with the first one
+    double     *ys;
+    bool       *split;
+    CurvePoint *work[2];
+
+    unsigned long long evaluated;   // samples computed
+    unsigned long long hits;
+    unsigned long long misses;
+} Curve;
+
+void             curve_init     (Curve *curve);
+void             curve_free     (Curve *curve);
+bool             curve_set      (Curve *curve, const char *src);
+int              curve_level_for(double pixelsPerUnit);
+const CurveTile *curve_tile     (Curve *curve, int level, int64_t index);
+
+
+#endif //RAYLIBPROJEKT_CURVE_H
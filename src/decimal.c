@@ -0,0 +1,729 @@
+/***********************************************************************************************************************
+ * @author Christian Reiswich
+ * @date 18 Oct. 2026
+ * @version 1.0
+ * @brief Raylib Calculator
+ * @details Inline coefficients take 64-bit fast paths (checked add, sub and mul, and division when it comes out
+ *          exact). Everything else goes through a fixed-size scratch number on the stack and is rounded back to
+ *          DEC_PRECISION digits, so no operation ever calls malloc. Results are normalized without trailing zeros.
+ **********************************************************************************************************************/
+
+#include "decimal.h"
+#include "numfmt.h"
+
+#include <string.h>
+
+#define DEC_BASE  1000000000u
+#define BIG_LIMBS 40            // 360 digits of scratch: two full coefficients plus alignment
+
+typedef struct {
+    uint32_t l[BIG_LIMBS];      // base 10^9, least significant first
+    int      n;                 // limbs in use, 0 for zero
+} Big;
+
+static const uint32_t pow10u32[] = {
+    1u, 10u, 100u, 1000u, 10000u, 100000u, 1000000u, 10000000u, 100000000u, 1000000000u
+};
+
+static const uint64_t pow10u64[] = {
+    1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull, 1000000000ull,
+    10000000000ull, 100000000000ull, 1000000000000ull, 10000000000000ull, 100000000000000ull,
+    1000000000000000ull, 10000000000000000ull, 100000000000000000ull, 1000000000000000000ull,
+    10000000000000000000ull
+};
+
+
+/* ---------------------------------------------------------------------------------------------------------------- */
+/* Arena                                                                                                             */
+/* ---------------------------------------------------------------------------------------------------------------- */
+
+void dec_arena_init(DecArena *arena, uint32_t *storage, size_t capLimbs) {
+    arena->base = storage;
+    arena->cap  = capLimbs;
+    arena->used = 0;
+}
+
+
+void dec_arena_reset(DecArena *arena) {
+    if(arena) arena->used = 0;
+}
+
+
+/* Drops everything in the arena except the limbs of `value`, which move to its start. */
+void dec_arena_keep(DecArena *arena, Dec *value) {
+    if(!arena) return;
+    if(!value->limbs) {
+        arena->used = 0;
+        return;
+    }
+    memmove(arena->base, value->limbs, value->nlimbs * sizeof(uint32_t));
+    value->limbs = arena->base;
+    arena->used  = value->nlimbs;
+}
+
+
+static uint32_t *arena_alloc(DecArena *arena, size_t n) {
+    if(!arena || arena->cap - arena->used < n) return NULL;
+
+    uint32_t *p = arena->base + arena->used;
+    arena->used += n;
+    return p;
+}
+
+
+/* ---------------------------------------------------------------------------------------------------------------- */
+/* Scratch numbers                                                                                                   */
+/* ---------------------------------------------------------------------------------------------------------------- */
+
+static void big_trim(Big *x) {
+    while(x->n > 0 && x->l[x->n - 1] == 0) x->n--;
+}
+
+
+static void big_set_u64(Big *x, uint64_t v) {
+    x->n = 0;
+    while(v) {
+        x->l[x->n++] = (uint32_t)(v % DEC_BASE);
+        v /= DEC_BASE;
+    }
+}
+
+
+static void big_from_dec(Big *x, const Dec *d) {
+    if(d->limbs) {
+        memcpy(x->l, d->limbs, d->nlimbs * sizeof(uint32_t));
+        x->n = d->nlimbs;
+        big_trim(x);
+    } else {
+        big_set_u64(x, d->small);
+    }
+}
+
+
+static bool big_mul_small(Big *x, uint32_t m) {
+    uint64_t carry = 0;
+    for(int i = 0; i < x->n; i++) {
+        uint64_t t = (uint64_t)x->l[i] * m + carry;
+        x->l[i] = (uint32_t)(t % DEC_BASE);
+        carry   = t / DEC_BASE;
+    }
+    if(carry) {
+        if(x->n >= BIG_LIMBS) return false;
+        x->l[x->n++] = (uint32_t)carry;
+    }
+    big_trim(x);
+    return true;
+}
+
+
+static bool big_add_small(Big *x, uint32_t v) {
+    uint64_t carry = v;
+    for(int i = 0; carry && i < x->n; i++) {
+        uint64_t t = x->l[i] + carry;
+        x->l[i] = (uint32_t)(t % DEC_BASE);
+        carry   = t / DEC_BASE;
+    }
+    if(carry) {
+        if(x->n >= BIG_LIMBS) return false;
+        x->l[x->n++] = (uint32_t)carry;
+    }
+    return true;
+}
+
+
+static uint32_t big_divmod_small(Big *x, uint32_t d) {
+    uint64_t rem = 0;
+    for(int i = x->n - 1; i >= 0; i--) {
+        uint64_t cur = rem * DEC_BASE + x->l[i];
+        x->l[i] = (uint32_t)(cur / d);
+        rem     = cur % d;
+    }
+    big_trim(x);
+    return (uint32_t)rem;
+}
+
+
+static bool big_shift10(Big *x, int64_t k) {
+    if(x->n == 0 || k == 0) return true;
+    if(k > (int64_t)BIG_LIMBS * 9) return false;
+
+    int limbs = (int)(k / 9);
+    if(limbs) {
+        if(x->n + limbs > BIG_LIMBS) return false;
+        memmove(x->l + limbs, x->l, (size_t)x->n * sizeof(uint32_t));
+        memset(x->l, 0, (size_t)limbs * sizeof(uint32_t));
+        x->n += limbs;
+    }
+    return big_mul_small(x, pow10u32[k % 9]);
+}
+
+
+static int big_digits(const Big *x) {
+    if(x->n == 0) return 0;
+
+    uint32_t top = x->l[x->n - 1];
+    int d = 1;
+    while(d < 9 && top >= pow10u32[d]) d++;
+    return (x->n - 1) * 9 + d;
+}
+
+
+static int big_cmp(const Big *a, const Big *b) {
+    if(a->n != b->n) return (a->n < b->n) ? -1 : 1;
+    for(int i = a->n - 1; i >= 0; i--) {
+        if(a->l[i] != b->l[i]) return (a->l[i] < b->l[i]) ? -1 : 1;
+    }
+    return 0;
+}
+
+
+static bool big_add(Big *r, const Big *a, const Big *b) {
+    int n = (a->n > b->n) ? a->n : b->n;
+    int na = a->n, nb = b->n;
+    uint32_t carry = 0;
+
+    for(int i = 0; i < n; i++) {
+        uint32_t t = ((i < na) ? a->l[i] : 0) + ((i < nb) ? b->l[i] : 0) + carry;
+        carry = (t >= DEC_BASE);
+        r->l[i] = carry ? t - DEC_BASE : t;
+    }
+    r->n = n;
+    if(carry) {
+        if(n >= BIG_LIMBS) return false;
+        r->l[r->n++] = 1;
+    }
+    return true;
+}
+
+
+/* r = a - b for a >= b */
+static void big_sub(Big *r, const Big *a, const Big *b) {
+    int na = a->n, nb = b->n;
+    uint32_t borrow = 0;
+
+    for(int i = 0; i < na; i++) {
+        int64_t t = (int64_t)a->l[i] - ((i < nb) ? b->l[i] : 0) - borrow;
+        borrow = (t < 0);
+        r->l[i] = (uint32_t)(borrow ? t + DEC_BASE : t);
+    }
+    r->n = na;
+    big_trim(r);
+}
+
+
+static bool big_mul(Big *r, const Big *a, const Big *b) {
+    r->n = 0;
+    if(a->n == 0 || b->n == 0) return true;
+    if(a->n + b->n > BIG_LIMBS) return false;
+
+    memset(r->l, 0, (size_t)(a->n + b->n) * sizeof(uint32_t));
+    for(int i = 0; i < a->n; i++) {
+        uint64_t carry = 0;
+        for(int j = 0; j < b->n; j++) {
+            uint64_t t = (uint64_t)a->l[i] * b->l[j] + r->l[i + j] + carry;
+            r->l[i + j] = (uint32_t)(t % DEC_BASE);
+            carry       = t / DEC_BASE;
+        }
+        r->l[i + b->n] = (uint32_t)carry;
+    }
+    r->n = a->n + b->n;
+    big_trim(r);
+    return true;
+}
+
+
+/* Long division by an inline coefficient, one base 10^9 limb per step. Returns the remainder. */
+static uint64_t big_divmod_u64(Big *x, uint64_t d) {
+    unsigned __int128 rem = 0;
+    for(int i = x->n - 1; i >= 0; i--) {
+        unsigned __int128 cur = rem * DEC_BASE + x->l[i];
+        x->l[i] = (uint32_t)(cur / d);
+        rem     = cur % d;
+    }
+    big_trim(x);
+    return (uint64_t)rem;
+}
+
+
+/* q = floor(a / b), one decimal digit at a time. Returns whether the remainder is nonzero. */
+static bool big_div(Big *q, const Big *a, const Big *b) {
+    Big rem;
+    rem.n = 0;
+    q->n  = 0;
+
+    for(int i = big_digits(a) - 1; i >= 0; i--) {
+        uint32_t digit = (a->l[i / 9] / pow10u32[i % 9]) % 10;
+        big_mul_small(&rem, 10);
+        big_add_small(&rem, digit);
+
+        uint32_t qd = 0;
+        while(big_cmp(&rem, b) >= 0) {
+            big_sub(&rem, &rem, b);
+            qd++;
+        }
+        big_mul_small(q, 10);
+        big_add_small(q, qd);
+    }
+    return rem.n != 0;
+}
+
+
+/* Rounds half-even to DEC_PRECISION digits; `sticky` tells whether nonzero digits were already cut off below x. */
+static void big_round(Big *x, int64_t *exp, bool sticky) {
+    int drop = big_digits(x) - DEC_PRECISION;
+    if(drop <= 0) return;
+
+    for(int k = drop - 1; k > 0; ) {
+        int chunk = (k > 9) ? 9 : k;
+        if(big_divmod_small(x, pow10u32[chunk])) sticky = true;
+        k -= chunk;
+    }
+    uint32_t last = big_divmod_small(x, 10);
+    *exp += drop;
+
+    if(last > 5 || (last == 5 && (sticky || (x->n && (x->l[0] & 1u))))) {
+        big_add_small(x, 1);
+        if(big_digits(x) > DEC_PRECISION) {
+            big_divmod_small(x, 10);
+            (*exp)++;
+        }
+    }
+}
+
+
+/* ---------------------------------------------------------------------------------------------------------------- */
+/* Storing results                                                                                                   */
+/* ---------------------------------------------------------------------------------------------------------------- */
+
+void dec_zero(Dec *out) {
+    out->small  = 0;
+    out->limbs  = NULL;
+    out->exp    = 0;
+    out->nlimbs = 0;
+    out->neg    = false;
+}
+
+
+static bool store_small(Dec *out, uint64_t coeff, int64_t exp, bool neg) {
+    if(coeff == 0) {
+        dec_zero(out);
+        return true;
+    }
+    while(coeff % 10 == 0) {
+        coeff /= 10;
+        exp++;
+    }
+    if(exp < -DEC_MAX_EXP) {
+        dec_zero(out);
+        return true;
+    }
+    if(exp > DEC_MAX_EXP) return false;
+
+    out->small  = coeff;
+    out->limbs  = NULL;
+    out->exp    = (int32_t)exp;
+    out->nlimbs = 0;
+    out->neg    = neg;
+    return true;
+}
+
+
+static bool store_big(Dec *out, Big *x, int64_t exp, bool neg, bool sticky, DecArena *arena) {
+    big_round(x, &exp, sticky);
+    if(x->n == 0) {
+        dec_zero(out);
+        return true;
+    }
+
+    int zeroLimbs = 0;
+    while(x->l[zeroLimbs] == 0) zeroLimbs++;
+    if(zeroLimbs) {
+        memmove(x->l, x->l + zeroLimbs, (size_t)(x->n - zeroLimbs) * sizeof(uint32_t));
+        x->n -= zeroLimbs;
+        exp  += 9 * zeroLimbs;
+    }
+    while(x->l[0] % 10 == 0) {
+        big_divmod_small(x, 10);
+        exp++;
+    }
+
+    if(x->n <= 2) {
+        uint64_t v = x->l[0] + ((x->n == 2) ? (uint64_t)x->l[1] * DEC_BASE : 0);
+        return store_small(out, v, exp, neg);
+    }
+    if(exp < -DEC_MAX_EXP) {
+        dec_zero(out);
+        return true;
+    }
+    if(exp > DEC_MAX_EXP) return false;
+
+    uint32_t *mem = arena_alloc(arena, (size_t)x->n);
+    if(!mem) return false;
+
+    memcpy(mem, x->l, (size_t)x->n * sizeof(uint32_t));
+    out->small  = 0;
+    out->limbs  = mem;
+    out->exp    = (int32_t)exp;
+    out->nlimbs = (uint16_t)x->n;
+    out->neg    = neg;
+    return true;
+}
+
+
+static bool dec_is_zero(const Dec *d) {
+    return d->limbs == NULL && d->small == 0;
+}
+
+
+/* ---------------------------------------------------------------------------------------------------------------- */
+/* Arithmetic                                                                                                        */
+/* ---------------------------------------------------------------------------------------------------------------- */
+
+static bool add_signed(Dec *out, const Dec *a, const Dec *b, bool bneg, DecArena *arena) {
+    if(dec_is_zero(b)) {
+        *out = *a;
+        return true;
+    }
+    if(dec_is_zero(a)) {
+        *out = *b;
+        out->neg = bneg;
+        return true;
+    }
+
+    if(!a->limbs && !b->limbs) {
+        uint64_t ca = a->small, cb = b->small;
+        int64_t  e  = a->exp;
+        bool aligned = true;
+
+        if(a->exp > b->exp) {
+            int64_t diff = (int64_t)a->exp - b->exp;
+            aligned = diff < 20 && !__builtin_mul_overflow(ca, pow10u64[diff], &ca);
+            e = b->exp;
+        } else if(b->exp > a->exp) {
+            int64_t diff = (int64_t)b->exp - a->exp;
+            aligned = diff < 20 && !__builtin_mul_overflow(cb, pow10u64[diff], &cb);
+        }
+
+        if(aligned) {
+            uint64_t sum;
+            if(a->neg == bneg) {
+                if(!__builtin_add_overflow(ca, cb, &sum)) return store_small(out, sum, e, a->neg);
+            } else if(ca >= cb) {
+                return store_small(out, ca - cb, e, a->neg);
+            } else {
+                return store_small(out, cb - ca, e, bneg);
+            }
+        }
+    }
+
+    Big A, B, R;
+    big_from_dec(&A, a);
+    big_from_dec(&B, b);
+    int64_t ea = a->exp, eb = b->exp;
+
+    /* An operand lying entirely below the rounding position only matters as a sticky digit; replacing it by a
+     * single 1 there keeps the rounded result identical and bounds the alignment shift. */
+    int64_t topA  = ea + big_digits(&A);
+    int64_t topB  = eb + big_digits(&B);
+    int64_t floor = ((topA > topB) ? topA : topB) - DEC_PRECISION - 3;
+    if(topA < floor) { big_set_u64(&A, 1); ea = floor - 1; }
+    if(topB < floor) { big_set_u64(&B, 1); eb = floor - 1; }
+
+    int64_t e = (ea < eb) ? ea : eb;
+    if(!big_shift10(&A, ea - e) || !big_shift10(&B, eb - e)) return false;
+
+    bool neg;
+    if(a->neg == bneg) {
+        if(!big_add(&R, &A, &B)) return false;
+        neg = a->neg;
+    } else if(big_cmp(&A, &B) >= 0) {
+        big_sub(&R, &A, &B);
+        neg = a->neg;
+    } else {
+        big_sub(&R, &B, &A);
+        neg = bneg;
+    }
+    return store_big(out, &R, e, neg, false, arena);
+}
+
+
+bool dec_add(Dec *out, const Dec *left, const Dec *right, DecArena *arena) {
+    return add_signed(out, left, right, right->neg, arena);
+}
+
+
+bool dec_sub(Dec *out, const Dec *left, const Dec *right, DecArena *arena) {
+    return add_signed(out, left, right, !right->neg, arena);
+}
+
+
+bool dec_mul(Dec *out, const Dec *left, const Dec *right, DecArena *arena) {
+    bool    neg = left->neg != right->neg;
+    int64_t exp = (int64_t)left->exp + right->exp;
+
+    if(!left->limbs && !right->limbs) {
+        uint64_t p;
+        if(!__builtin_mul_overflow(left->small, right->small, &p)) return store_small(out, p, exp, neg);
+    }
+
+    Big A, B, R;
+    big_from_dec(&A, left);
+    big_from_dec(&B, right);
+    if(!big_mul(&R, &A, &B)) return false;
+    return store_big(out, &R, exp, neg, false, arena);
+}
+
+
+bool dec_div(Dec *out, const Dec *left, const Dec *right, DecArena *arena) {
+    if(dec_is_zero(right)) return false;
+    if(dec_is_zero(left)) {
+        dec_zero(out);
+        return true;
+    }
+
+    bool    neg = left->neg != right->neg;
+    int64_t exp = (int64_t)left->exp - right->exp;
+
+    if(!left->limbs && !right->limbs) {
+        uint64_t num = left->small, den = right->small;
+        for(int k = 0; k < 20; k++) {
+            if(num % den == 0) return store_small(out, num / den, exp - k, neg);
+            if(__builtin_mul_overflow(num, 10u, &num)) break;
+        }
+    }
+
+    Big A, B, Q;
+    big_from_dec(&A, left);
+    big_from_dec(&B, right);
+
+    int64_t k = DEC_PRECISION + 1 + big_digits(&B) - big_digits(&A);
+    if(k < 0) k = 0;
+    if(!big_shift10(&A, k)) return false;
+
+    bool inexact;
+    if(!right->limbs) {
+        Q = A;
+        inexact = big_divmod_u64(&Q, right->small) != 0;
+    } else {
+        inexact = big_div(&Q, &A, &B);
+    }
+    return store_big(out, &Q, exp - k, neg, inexact, arena);
+}
+
+
+bool dec_pct(Dec *out, const Dec *value) {
+    *out = *value;
+    if(dec_is_zero(value)) return true;
+    if(value->exp - 2 < -DEC_MAX_EXP) {
+        dec_zero(out);
+        return true;
+    }
+    out->exp -= 2;
+    return true;
+}
+
+
+bool dec_eval(Dec *out, const Dec *left, const Dec *right, char op, DecArena *arena) {
+    switch (op) {
+        case '+': return dec_add(out, left, right, arena);
+        case '-': return dec_sub(out, left, right, arena);
+        case '*': return dec_mul(out, left, right, arena);
+        case '/': return dec_div(out, left, right, arena);
+        default:  *out = *right; return true;
+    }
+}
+
+
+/* ---------------------------------------------------------------------------------------------------------------- */
+/* Text                                                                                                              */
+/* ---------------------------------------------------------------------------------------------------------------- */
+
+static bool is_digit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+
+/* Like parse_number(): text that is not a number reads as zero. Fails only when the value does not fit. */
+bool dec_parse(Dec *out, const char *str, size_t len, DecArena *arena) {
+    const char *p   = str;
+    const char *end = str + len;
+
+    while(p < end && (*p == ' ' || *p == '\t')) p++;
+    bool neg = false;
+    if(p < end && (*p == '-' || *p == '+')) {
+        neg = (*p == '-');
+        p++;
+    }
+
+    uint64_t small  = 0;
+    Big      big;
+    bool     isBig  = false;
+    bool     sticky = false;
+    bool     point  = false;
+    int      kept   = 0;
+    int64_t  exp    = 0;
+
+    for(; p < end; p++) {
+        if((*p == ',' || *p == '.') && !point) {
+            point = true;
+            continue;
+        }
+        if(!is_digit(*p)) break;
+
+        uint32_t d = (uint32_t)(*p - '0');
+        if(kept == 0 && d == 0) {
+            if(point) exp--;
+            continue;
+        }
+        if(kept > DEC_PRECISION) {
+            if(d) sticky = true;
+            if(!point) exp++;
+            continue;
+        }
+
+        if(!isBig && kept == 19) {
+            big_set_u64(&big, small);
+            isBig = true;
+        }
+        if(isBig) {
+            big_mul_small(&big, 10);
+            big_add_small(&big, d);
+        } else {
+            small = small * 10 + d;
+        }
+        kept++;
+        if(point) exp--;
+    }
+
+    if(p < end && (*p == 'e' || *p == 'E')) {
+        const char *q = p + 1;
+        bool expNeg = false;
+        if(q < end && (*q == '-' || *q == '+')) {
+            expNeg = (*q == '-');
+            q++;
+        }
+        int64_t value = 0;
+        for(; q < end && is_digit(*q); q++) {
+            if(value < 10 * (int64_t)DEC_MAX_EXP) value = value * 10 + (*q - '0');
+        }
+        exp += expNeg ? -value : value;
+    }
+
+    if(!isBig) return store_small(out, small, exp, neg);
+    return store_big(out, &big, exp, neg, sticky, arena);
+}
+
+
+static int coeff_digits(const Dec *value, char *digits) {
+    int n = 0;
+    if(!value->limbs) {
+        char tmp[24];
+        uint64_t v = value->small;
+        do {
+            tmp[n++] = (char)('0' + v % 10);
+            v /= 10;
+        } while(v);
+        for(int i = 0; i < n; i++) digits[i] = tmp[n - 1 - i];
+        return n;
+    }
+
+    int top = value->nlimbs - 1;
+    uint32_t v = value->limbs[top];
+    char tmp[10];
+    int t = 0;
+    do {
+        tmp[t++] = (char)('0' + v % 10);
+        v /= 10;
+    } while(v);
+    while(t) digits[n++] = tmp[--t];
+
+    for(int i = top - 1; i >= 0; i--) {
+        v = value->limbs[i];
+        for(int k = 8; k >= 0; k--) {
+            digits[n + k] = (char)('0' + v % 10);
+            v /= 10;
+        }
+        n += 9;
+    }
+    return n;
+}
+
+
+static size_t put_exponent(char *p, int64_t exp) {
+    char tmp[12];
+    size_t n = 0, t = 0;
+
+    p[n++] = 'e';
+    p[n++] = (exp < 0) ? '-' : '+';
+    if(exp < 0) exp = -exp;
+    do {
+        tmp[t++] = (char)('0' + exp % 10);
+        exp /= 10;
+    } while(exp);
+    if(t < 2) tmp[t++] = '0';
+    while(t) p[n++] = tmp[--t];
+    return n;
+}
+
+
+/* Same layout as format_number(): plain digits unless the exponent is below -4 or beyond the precision. */
+size_t dec_format(char *outStr, size_t cap, const Dec *value) {
+    if(cap == 0) return 0;
+
+    char digits[DEC_MAX_LIMBS * 9 + 9];
+    char text[DEC_MAX_LIMBS * 9 + 32];
+    size_t n = 0;
+
+    if(dec_is_zero(value)) {
+        text[n++] = '0';
+    } else {
+        int len = coeff_digits(value, digits);
+        int64_t exp10 = (int64_t)len - 1 + value->exp;
+        if(value->neg) text[n++] = '-';
+
+        if(exp10 < -4 || exp10 >= DEC_PRECISION) {
+            text[n++] = digits[0];
+            if(len > 1) {
+                text[n++] = ',';
+                memcpy(text + n, digits + 1, (size_t)(len - 1));
+                n += (size_t)(len - 1);
+            }
+            n += put_exponent(text + n, exp10);
+        } else if(exp10 < 0) {
+            text[n++] = '0';
+            text[n++] = ',';
+            for(int64_t i = -1; i > exp10; i--) text[n++] = '0';
+            memcpy(text + n, digits, (size_t)len);
+            n += (size_t)len;
+        } else {
+            int whole = (int)exp10 + 1;
+            if(len <= whole) {
+                memcpy(text + n, digits, (size_t)len);
+                n += (size_t)len;
+                for(int i = len; i < whole; i++) text[n++] = '0';
+            } else {
+                memcpy(text + n, digits, (size_t)whole);
+                n += (size_t)whole;
+                text[n++] = ',';
+                memcpy(text + n, digits + whole, (size_t)(len - whole));
+                n += (size_t)(len - whole);
+            }
+        }
+    }
+
+    if(n + 1 > cap) n = cap - 1;
+    memcpy(outStr, text, n);
+    outStr[n] = '\0';
+    return n;
+}
+
+
+double dec_to_double(const Dec *value) {
+    char text[DEC_MAX_LIMBS * 9 + 32];
+    size_t n = 0;
+
+    if(value->neg) text[n++] = '-';
+    n += (size_t)coeff_digits(value, text + n);
+    n += put_exponent(text + n, value->exp);
+    return numfmt_parse(text, n, NULL);
+}
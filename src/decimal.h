@@ -0,0 +1,55 @@
+/***********************************************************************************************************************
+ * @author Christian Reiswich
+ * @date 18 Oct. 2026
+ * @version 1.0
+ * @brief Raylib Calculator
+ * @details Decimal arithmetic backend: value = coefficient * 10^exp. Coefficients up to 19 digits live inline in
+ *          the Dec itself, longer ones (up to DEC_PRECISION digits) in base 10^9 limbs taken from a DecArena.
+ *          Sums, differences and products are exact within DEC_PRECISION significant digits, quotients are
+ *          rounded half-even to DEC_PRECISION digits.
+ **********************************************************************************************************************/
+
+#ifndef RAYLIBPROJEKT_DECIMAL_H
+#define RAYLIBPROJEKT_DECIMAL_H
+
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define DEC_PRECISION 50        // significant digits kept by every operation
+#define DEC_MAX_EXP   999999    // |exp| beyond this is an overflow
+#define DEC_MAX_LIMBS 6         // limbs of a DEC_PRECISION digit coefficient
+
+typedef struct {
+    uint64_t  small;    // coefficient while limbs == NULL
+    uint32_t *limbs;    // coefficient in base 10^9, least significant first, or NULL
+    int32_t   exp;
+    uint16_t  nlimbs;
+    bool      neg;
+} Dec;
+
+typedef struct {
+    uint32_t *base;
+    size_t    cap;      // in limbs
+    size_t    used;
+} DecArena;
+
+void   dec_arena_init (DecArena *arena, uint32_t *storage, size_t capLimbs);
+void   dec_arena_reset(DecArena *arena);
+void   dec_arena_keep (DecArena *arena, Dec *value);
+
+void   dec_zero     (Dec *out);
+bool   dec_parse    (Dec *out, const char *str, size_t len, DecArena *arena);
+size_t dec_format   (char *outStr, size_t cap, const Dec *value);
+double dec_to_double(const Dec *value);
+
+bool dec_add (Dec *out, const Dec *left, const Dec *right, DecArena *arena);
+bool dec_sub (Dec *out, const Dec *left, const Dec *right, DecArena *arena);
+bool dec_mul (Dec *out, const Dec *left, const Dec *right, DecArena *arena);
+bool dec_div (Dec *out, const Dec *left, const Dec *right, DecArena *arena);
+bool dec_pct (Dec *out, const Dec *value);
+bool dec_eval(Dec *out, const Dec *left, const Dec *right, char op, DecArena *arena);
+
+
+#endif //RAYLIBPROJEKT_DECIMAL_H
@@ -0,0 +1,133 @@
+/***********************************************************************************************************************
+ * @author Christian Reiswich
+ * @date 18 Oct. 2026
+ * @version 1.0
+ * @brief Raylib Calculator
+ * @details
+ **********************************************************************************************************************/
+
+#include "engine.h"
+
+#include <sched.h>
+#include <string.h>
+
+
+void engine_view_of(const Calc *calc, uint64_t keys, EngineView *view) {
+    memcpy(view->display, calc->display, sizeof(view->display));
+    view->lastWasEq = calc->lastWasEq;
+    view->pending   = calc->pending;
+    view->keys      = keys;
+}
+
+
+static void publish(Engine *engine) {
+    unsigned seq = engine->seq;
+    __atomic_store_n(&engine->seq, seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    engine_view_of(&engine->calc, engine->taken, &engine->view);
+    __atomic_store_n(&engine->seq, seq + 2, __ATOMIC_RELEASE);
+}
+
+
+/* Sleeps until the ring holds a key at `tail` or the engine is stopped; only called once the ring was seen empty.
+ * The store to `sleeping` and the load of `head` are sequentially consistent, as are the two in engine_push(), so
+ * either the push sees the engine asleep and signals, or the engine sees the key before it waits. */
+static bool wait_for_keys(Engine *engine, unsigned tail) {
+    pthread_mutex_lock(&engine->lock);
+    __atomic_store_n(&engine->sleeping, true, __ATOMIC_SEQ_CST);
+    while(__atomic_load_n(&engine->head, __ATOMIC_SEQ_CST) == tail && !engine->stop) {
+        pthread_cond_wait(&engine->wake, &engine->lock);
+    }
+    __atomic_store_n(&engine->sleeping, false, __ATOMIC_SEQ_CST);
+    bool run = (__atomic_load_n(&engine->head, __ATOMIC_SEQ_CST) != tail) || !engine->stop;
+    pthread_mutex_unlock(&engine->lock);
+    return run;
+}
+
+
+/* Drains the ring without any lock while keys keep coming; the mutex is only taken to sleep on an empty ring. */
+static void *engine_main(void *arg) {
+    Engine *engine = arg;
+    unsigned tail = engine->tail;
+
+    for(;;) {
+        unsigned head = __atomic_load_n(&engine->head, __ATOMIC_ACQUIRE);
+        if(head == tail) {
+            if(!wait_for_keys(engine, tail)) return NULL;
+            continue;
+        }
+        while(tail != head) {
+            calc_press_key(&engine->calc, engine->keys[tail & (ENGINE_RING_LEN - 1)]);
+            tail++;
+            engine->taken++;
+        }
+        __atomic_store_n(&engine->tail, tail, __ATOMIC_RELEASE);
+        publish(engine);
+    }
+}
+
+
+bool engine_start(Engine *engine, History *history) {
+    memset(engine, 0, sizeof(*engine));
+    calc_init(&engine->calc);
+    calc_set_history(&engine->calc, history);
+    engine_view_of(&engine->calc, 0, &engine->view);
+
+    if(pthread_mutex_init(&engine->lock, NULL) != 0) return false;
+    if(pthread_cond_init(&engine->wake, NULL) != 0) {
+        pthread_mutex_destroy(&engine->lock);
+        return false;
+    }
+    if(pthread_create(&engine->thread, NULL, engine_main, engine) != 0) {
+        pthread_cond_destroy(&engine->wake);
+        pthread_mutex_destroy(&engine->lock);
+        return false;
+    }
+    return true;
+}
+
+
+/* Lets the engine finish the keys already pushed, then joins it. */
+void engine_stop(Engine *engine) {
+    pthread_mutex_lock(&engine->lock);
+    engine->stop = true;
+    pthread_cond_signal(&engine->wake);
+    pthread_mutex_unlock(&engine->lock);
+
+    pthread_join(engine->thread, NULL);
+    pthread_cond_destroy(&engine->wake);
+    pthread_mutex_destroy(&engine->lock);
+}
+
+
+/* UI thread only. False if the ring is full; the key is not taken then. */
+bool engine_push(Engine *engine, char key) {
+    unsigned head = engine->head;
+    if(head - __atomic_load_n(&engine->tail, __ATOMIC_ACQUIRE) >= ENGINE_RING_LEN) return false;
+
+    engine->keys[head & (ENGINE_RING_LEN - 1)] = key;
+    __atomic_store_n(&engine->head, head + 1, __ATOMIC_SEQ_CST);
+
+    if(__atomic_load_n(&engine->sleeping, __ATOMIC_SEQ_CST)) {
+        pthread_mutex_lock(&engine->lock);
+        pthread_cond_signal(&engine->wake);
+        pthread_mutex_unlock(&engine->lock);
+    }
+    return true;
+}
+
+
+/* The latest snapshot, from any thread. Retries while the engine is in the middle of publishing one. */
+void engine_read(const Engine *engine, EngineView *view) {
+    for(;;) {
+        unsigned before = __atomic_load_n(&engine->seq, __ATOMIC_ACQUIRE);
+        if(before & 1) {
+            sched_yield();
+            continue;
+        }
+
+        memcpy(view, &engine->view, sizeof(*view));
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if(__atomic_load_n(&engine->seq, __ATOMIC_RELAXED) == before) return;
+    }
+}
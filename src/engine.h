@@ -0,0 +1,59 @@
+/***********************************************************************************************************************
+ * @author Christian Reiswich
+ * @date 18 Oct. 2026
+ * @version 1.0
+ * @brief Raylib Calculator
+ * @details Runs a Calc on its own thread, so a slow calculation (the decimal backend, a long tape write) never holds
+ *          up a frame. The UI thread hands keys over through a single-producer ring and reads the result through
+ *          a seqlock: the engine bumps the sequence to odd, writes the snapshot and bumps it to even again, and a
+ *          reader copies the snapshot and retries if the sequence was odd or moved meanwhile. Neither side takes a
+ *          lock; the mutex is only there for the engine to sleep on while the ring is empty.
+ *
+ *          The engine owns the Calc, and with it the history tape, until engine_stop().
+ **********************************************************************************************************************/
+
+#ifndef RAYLIBPROJEKT_ENGINE_H
+#define RAYLIBPROJEKT_ENGINE_H
+
+#pragma once
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "calc.h"
+
+#define ENGINE_RING_LEN 256         // power of two
+#define ENGINE_LINE     64          // keeps the producer and consumer indices on separate cache lines
+
+typedef struct {
+    char     display[64];
+    bool     lastWasEq;
+    char     pending;
+    uint64_t keys;                  // keys the engine has taken from the ring so far
+} EngineView;
+
+typedef struct {
+    unsigned head __attribute__((aligned(ENGINE_LINE)));    // written by the UI thread only
+    char     keys[ENGINE_RING_LEN];
+
+    unsigned tail __attribute__((aligned(ENGINE_LINE)));    // written by the engine only
+    uint64_t taken;
+    Calc     calc;
+
+    unsigned   seq __attribute__((aligned(ENGINE_LINE)));   // odd while `view` is being written
+    EngineView view;
+
+    pthread_t       thread;
+    pthread_mutex_t lock;
+    pthread_cond_t  wake;
+    bool            sleeping;
+    bool            stop;
+} Engine;
+
+bool engine_start  (Engine *engine, History *history);
+void engine_stop   (Engine *engine);
+bool engine_push   (Engine *engine, char key);
+void engine_read   (const Engine *engine, EngineView *view);
+void engine_view_of(const Calc *calc, uint64_t keys, EngineView *view);
+
+
+#endif //RAYLIBPROJEKT_ENGINE_H
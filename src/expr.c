@@ -0,0 +1,312 @@
+/***********************************************************************************************************************
+ * @author Christian Reiswich
+ * @date 18 Oct. 2026
+ * @version 1.0
+ * @brief Raylib Calculator
+ * @details Recursive descent parser emitting stack bytecode. Precedence from low to high:
+ *          binary + -, binary * /, unary + -, postfix %, then numbers, names and parentheses.
+ **********************************************************************************************************************/
+
+#include "expr.h"
+#include "numfmt.h"
+
+#include <string.h>
+#include <math.h>
+
+#define EXPR_MAX_NESTING 64
+
+
+typedef struct {
+    ExprProgram *prog;
+    const char  *src;
+    const char  *p;
+    int          depth;
+    int          nesting;
+} Parser;
+
+
+static bool fail(Parser *ps, const char *message) {
+    if(ps->prog->error == NULL) {
+        ps->prog->error    = message;
+        ps->prog->errorPos = (int)(ps->p - ps->src);
+    }
+    return false;
+}
+
+
+static void skip_space(Parser *ps) {
+    while(*ps->p == ' ' || *ps->p == '\t') ps->p++;
+}
+
+
+static bool is_alpha(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+}
+
+
+static bool is_digit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+
+static bool emit(Parser *ps, ExprOp op, int arg) {
+    ExprProgram *prog = ps->prog;
+    if(prog->codeLen >= EXPR_MAX_CODE) return fail(ps, "expression too long");
+
+    prog->code[prog->codeLen].op  = (uint8_t)op;
+    prog->code[prog->codeLen].arg = (uint8_t)arg;
+    prog->codeLen++;
+
+    if(op == EXPR_OP_CONST || op == EXPR_OP_VAR) {
+        if(++ps->depth > prog->maxStack) prog->maxStack = ps->depth;
+        if(ps->depth > EXPR_MAX_STACK) return fail(ps, "expression too deep");
+    } else if(op != EXPR_OP_NEG && op != EXPR_OP_PCT) {
+        ps->depth--;
+    }
+    return true;
+}
+
+
+static bool emit_const(Parser *ps, double value) {
+    ExprProgram *prog = ps->prog;
+    if(prog->constCount >= EXPR_MAX_CONSTS) return fail(ps, "too many numbers");
+
+    prog->consts[prog->constCount] = value;
+    return emit(ps, EXPR_OP_CONST, prog->constCount++);
+}
+
+
+static bool last_is_const(const ExprProgram *prog, int back) {
+    return prog->codeLen >= back && prog->code[prog->codeLen - back].op == EXPR_OP_CONST;
+}
+
+
+static double apply(ExprOp op, double left, double right) {
+    switch (op) {
+        case EXPR_OP_ADD: return left + right;
+        case EXPR_OP_SUB: return left - right;
+        case EXPR_OP_MUL: return left * right;
+        case EXPR_OP_DIV: return (right != 0.0) ? (left / right) : NAN;
+        case EXPR_OP_NEG: return -right;
+        case EXPR_OP_PCT: return right / 100.0;
+        default:          return right;
+    }
+}
+
+
+/* Emits an operator, folding it into the preceding constant(s) when all of its operands are literals. An
+ * operand whose last instruction is CONST is always that single constant, so the check is local. */
+static bool emit_op(Parser *ps, ExprOp op) {
+    ExprProgram *prog = ps->prog;
+    bool unary = (op == EXPR_OP_NEG || op == EXPR_OP_PCT);
+
+    if(unary && last_is_const(prog, 1)) {
+        double *slot = &prog->consts[prog->code[prog->codeLen - 1].arg];
+        *slot = apply(op, 0.0, *slot);
+        return true;
+    }
+    if(!unary && last_is_const(prog, 1) && last_is_const(prog, 2)) {
+        int right = prog->code[prog->codeLen - 1].arg;
+        int left  = prog->code[prog->codeLen - 2].arg;
+        prog->consts[left] = apply(op, prog->consts[left], prog->consts[right]);
+        if(right == prog->constCount - 1) prog->constCount--;
+        prog->codeLen--;
+        ps->depth--;
+        return true;
+    }
+    return emit(ps, op, 0);
+}
+
+
+static bool parse_sum(Parser *ps);
+
+
+static bool parse_number_token(Parser *ps) {
+    const char *start = ps->p;
+    const char *q = start;
+    int digits = 0;
+
+    while(is_digit(*q)) { q++; digits++; }
+    if(*q == ',' || *q == '.') {
+        q++;
+        while(is_digit(*q)) { q++; digits++; }
+    }
+    if(digits == 0) return fail(ps, "expected a number");
+
+    if(*q == 'e' || *q == 'E') {
+        const char *e = q + 1;
+        if(*e == '+' || *e == '-') e++;
+        if(is_digit(*e)) {
+            while(is_digit(*e)) e++;
+            q = e;
+        }
+    }
+
+    ps->p = q;
+    return emit_const(ps, numfmt_parse(start, (size_t)(q - start), NULL));
+}
+
+
+static bool parse_name(Parser *ps) {
+    ExprProgram *prog = ps->prog;
+    const char *start = ps->p;
+
+    while(is_alpha(*ps->p) || is_digit(*ps->p)) ps->p++;
+    size_t strLength = (size_t)(ps->p - start);
+    if(strLength >= EXPR_NAME_LEN) {
+        ps->p = start;
+        return fail(ps, "name too long");
+    }
+
+    for(int i = 0; i < prog->varCount; i++) {
+        if(strncmp(prog->vars[i], start, strLength) == 0 && prog->vars[i][strLength] == '\0') {
+            return emit(ps, EXPR_OP_VAR, i);
+        }
+    }
+
+    if(prog->varCount >= EXPR_MAX_VARS) {
+        ps->p = start;
+        return fail(ps, "too many names");
+    }
+    memcpy(prog->vars[prog->varCount], start, strLength);
+    prog->vars[prog->varCount][strLength] = '\0';
+    return emit(ps, EXPR_OP_VAR, prog->varCount++);
+}
+
+
+static bool parse_primary(Parser *ps) {
+    skip_space(ps);
+    char c = *ps->p;
+
+    if(c == '(') {
+        if(++ps->nesting > EXPR_MAX_NESTING) return fail(ps, "too many parentheses");
+        ps->p++;
+        if(!parse_sum(ps)) return false;
+        skip_space(ps);
+        if(*ps->p != ')') return fail(ps, "expected ')'");
+        ps->p++;
+        ps->nesting--;
+        return true;
+    }
+    if(is_digit(c) || c == ',' || c == '.') return parse_number_token(ps);
+    if(is_alpha(c)) return parse_name(ps);
+    if(c == '\0') return fail(ps, "unexpected end of expression");
+    return fail(ps, "unexpected character");
+}
+
+
+static bool parse_postfix(Parser *ps) {
+    if(!parse_primary(ps)) return false;
+
+    for(;;) {
+        skip_space(ps);
+        if(*ps->p != '%') return true;
+        ps->p++;
+        if(!emit_op(ps, EXPR_OP_PCT)) return false;
+    }
+}
+
+
+static bool parse_unary(Parser *ps) {
+    skip_space(ps);
+    char c = *ps->p;
+
+    if(c == '-' || c == '+') {
+        if(++ps->nesting > EXPR_MAX_NESTING) return fail(ps, "too many signs");
+        ps->p++;
+        if(!parse_unary(ps)) return false;
+        ps->nesting--;
+        return (c == '-') ? emit_op(ps, EXPR_OP_NEG) : true;
+    }
+    return parse_postfix(ps);
+}
+
+
+static bool parse_product(Parser *ps) {
+    if(!parse_unary(ps)) return false;
+
+    for(;;) {
+        skip_space(ps);
+        char c = *ps->p;
+        if(c != '*' && c != '/') return true;
+        ps->p++;
+        if(!parse_unary(ps)) return false;
+        if(!emit_op(ps, (c == '*') ? EXPR_OP_MUL : EXPR_OP_DIV)) return false;
+    }
+}
+
+
+static bool parse_sum(Parser *ps) {
+    if(!parse_product(ps)) return false;
+
+    for(;;) {
+        skip_space(ps);
+        char c = *ps->p;
+        if(c != '+' && c != '-') return true;
+        ps->p++;
+        if(!parse_product(ps)) return false;
+        if(!emit_op(ps, (c == '+') ? EXPR_OP_ADD : EXPR_OP_SUB)) return false;
+    }
+}
+
+
+bool expr_compile(ExprProgram *prog, const char *src) {
+    prog->codeLen    = 0;
+    prog->constCount = 0;
+    prog->varCount   = 0;
+    prog->maxStack   = 0;
+    prog->errorPos   = -1;
+    prog->error      = NULL;
+
+    Parser ps = { .prog = prog, .src = src, .p = src, .depth = 0, .nesting = 0 };
+    if(!parse_sum(&ps)) return false;
+
+    skip_space(&ps);
+    if(*ps.p != '\0') return fail(&ps, (*ps.p == ')') ? "unbalanced ')'" : "unexpected character");
+    return true;
+}
+
+
+int expr_var_index(const ExprProgram *prog, const char *name) {
+    for(int i = 0; i < prog->varCount; i++) {
+        if(strcmp(prog->vars[i], name) == 0) return i;
+    }
+    return -1;
+}
+
+
+/* The top of the stack lives in a local so most instructions touch only one memory slot. */
+double expr_run(const ExprProgram *prog, const double *vars) {
+    double stack[EXPR_MAX_STACK + 1];
+    double top = 0.0;
+    int    sp  = 0;
+
+    const ExprInsn *pc  = prog->code;
+    const ExprInsn *end = pc + prog->codeLen;
+
+    for(; pc < end; ++pc) {
+        switch (pc->op) {
+            case EXPR_OP_CONST: stack[sp++] = top; top = prog->consts[pc->arg]; break;
+            case EXPR_OP_VAR:   stack[sp++] = top; top = vars[pc->arg];         break;
+            case EXPR_OP_ADD:   top = stack[--sp] + top; break;
+            case EXPR_OP_SUB:   top = stack[--sp] - top; break;
+            case EXPR_OP_MUL:   top = stack[--sp] * top; break;
+            case EXPR_OP_DIV: {
+                double left = stack[--sp];
+                top = (top != 0.0) ? (left / top) : NAN;
+                break;
+            }
+            case EXPR_OP_NEG:   top = -top;         break;
+            case EXPR_OP_PCT:   top = top / 100.0;  break;
+            default:            break;
+        }
+    }
+    return top;
+}
+
+
+void expr_run_batch(const ExprProgram *prog, const double *vars, size_t stride, double *out, size_t count) {
+    for(size_t i = 0; i < count; i++) {
+        out[i] = expr_run(prog, vars + i * stride);
+    }
+}
@@ -0,0 +1,59 @@
+/***********************************************************************************************************************
+ * @author Christian Reiswich
+ * @date 18 Oct. 2026
+ * @version 1.0
+ * @brief Raylib Calculator
+ * @details Expression compiler and bytecode VM. A formula such as "-(a + 2,5) * b%" is parsed once into a
+ *          compact program; expr_run() then evaluates it on doubles without touching any text. The binary
+ *          operators behave exactly like eval() (division by zero yields NaN, shown as "Error").
+ **********************************************************************************************************************/
+
+#ifndef RAYLIBPROJEKT_EXPR_H
+#define RAYLIBPROJEKT_EXPR_H
+
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define EXPR_MAX_CODE   256
+#define EXPR_MAX_CONSTS 64
+#define EXPR_MAX_VARS   16
+#define EXPR_MAX_STACK  32
+#define EXPR_NAME_LEN   16
+
+typedef enum {
+    EXPR_OP_CONST,   // push consts[arg]
+    EXPR_OP_VAR,     // push vars[arg]
+    EXPR_OP_ADD,
+    EXPR_OP_SUB,
+    EXPR_OP_MUL,
+    EXPR_OP_DIV,
+    EXPR_OP_NEG,
+    EXPR_OP_PCT      // x / 100, like the % key
+} ExprOp;
+
+typedef struct {
+    uint8_t op;
+    uint8_t arg;
+} ExprInsn;
+
+typedef struct {
+    ExprInsn    code[EXPR_MAX_CODE];
+    double      consts[EXPR_MAX_CONSTS];
+    char        vars[EXPR_MAX_VARS][EXPR_NAME_LEN];
+    int         codeLen;
+    int         constCount;
+    int         varCount;
+    int         maxStack;
+    int         errorPos;   // byte offset of the error in the source, -1 on success
+    const char *error;
+} ExprProgram;
+
+bool   expr_compile  (ExprProgram *prog, const char *src);
+int    expr_var_index(const ExprProgram *prog, const char *name);
+double expr_run      (const ExprProgram *prog, const double *vars);
+void   expr_run_batch(const ExprProgram *prog, const double *vars, size_t stride, double *out, size_t count);
+
+
+#endif //RAYLIBPROJEKT_EXPR_H
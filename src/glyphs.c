@@ -0,0 +1,137 @@
+/***********************************************************************************************************************
+ * @author Christian Reiswich
+ * @date 18 Oct. 2026
+ * @version 1.0
+ * @brief Raylib Calculator
+ * @details Glyphs are scaled nearest neighbour, like DrawText() does on the GPU, so the look does not change.
+ **********************************************************************************************************************/
+
+#include "glyphs.h"
+
+#include <math.h>
+#include <stddef.h>
+
+#define GLYPH_SIZES     2
+#define GLYPH_MAX       256
+#define ATLAS_WIDTH     512
+#define ATLAS_PADDING   1
+#define ATLAS_WHITE     4       // white block in the top left corner, used for shapes
+
+
+static const int sizes[GLYPH_SIZES] = { GLYPH_LABEL_SIZE, GLYPH_DISPLAY_SIZE };
+
+static Font      fonts[GLYPH_SIZES];
+static Rectangle recs [GLYPH_SIZES][GLYPH_MAX];
+static GlyphInfo infos[GLYPH_SIZES][GLYPH_MAX];
+static Texture2D atlas;
+static bool      loaded = false;
+
+
+static const Font *font_for(int fontSize) {
+    if(!loaded) return NULL;
+    for(int k = 0; k < GLYPH_SIZES; k++) {
+        if(sizes[k] == fontSize) return &fonts[k];
+    }
+    return NULL;
+}
+
+
+/* Shelf packing: places every glyph of every size, left to right, in rows as high as the font. */
+static int layout(const Font *def, int count) {
+    int x = ATLAS_WHITE + ATLAS_PADDING;
+    int y = 0;
+
+    for(int k = 0; k < GLYPH_SIZES; k++) {
+        float scale = (float)sizes[k] / (float)def->baseSize;
+        for(int i = 0; i < count; i++) {
+            int w = (int)lroundf(def->recs[i].width * scale);
+            int h = (int)lroundf(def->recs[i].height * scale);
+            if(x + w > ATLAS_WIDTH) {
+                x  = 0;
+                y += sizes[k] + ATLAS_PADDING;
+            }
+            recs[k][i] = (Rectangle){ (float)x, (float)y, (float)w, (float)h };
+
+            infos[k][i]          = def->glyphs[i];
+            infos[k][i].offsetX  = (int)lroundf(def->glyphs[i].offsetX * scale);
+            infos[k][i].offsetY  = (int)lroundf(def->glyphs[i].offsetY * scale);
+            infos[k][i].advanceX = (int)lroundf(def->glyphs[i].advanceX * scale);
+            infos[k][i].image    = (Image){ 0 };
+            x += w + ATLAS_PADDING;
+        }
+        x  = 0;
+        y += sizes[k] + ATLAS_PADDING;
+    }
+    return y;
+}
+
+
+bool glyphs_load(void) {
+    Font def = GetFontDefault();
+    int count = (def.glyphCount < GLYPH_MAX) ? def.glyphCount : GLYPH_MAX;
+    if(count <= 0 || def.baseSize <= 0) return false;
+
+    int height = layout(&def, count);
+    Image src = LoadImageFromTexture(def.texture);
+    Image img = GenImageColor(ATLAS_WIDTH, height, BLANK);
+    ImageDrawRectangle(&img, 0, 0, ATLAS_WHITE, ATLAS_WHITE, WHITE);
+
+    for(int k = 0; k < GLYPH_SIZES; k++) {
+        for(int i = 0; i < count; i++) {
+            Rectangle dst = recs[k][i];
+            if(dst.width <= 0 || dst.height <= 0) continue;
+
+            Image g = ImageFromImage(src, def.recs[i]);
+            ImageResizeNN(&g, (int)dst.width, (int)dst.height);
+            ImageDraw(&img, g, (Rectangle){ 0, 0, dst.width, dst.height }, dst, WHITE);
+            UnloadImage(g);
+        }
+
+        fonts[k] = (Font){
+            .baseSize     = sizes[k],
+            .glyphCount   = count,
+            .glyphPadding = 0,
+            .recs         = recs[k],
+            .glyphs       = infos[k]
+        };
+    }
+
+    atlas = LoadTextureFromImage(img);
+    UnloadImage(img);
+    UnloadImage(src);
+    if(atlas.id == 0) return false;
+
+    SetTextureFilter(atlas, TEXTURE_FILTER_POINT);
+    for(int k = 0; k < GLYPH_SIZES; k++) fonts[k].texture = atlas;
+
+    // Rechtecke aus demselben Atlas zeichnen, damit Flächen und Beschriftungen nicht den Batch wechseln
+    SetShapesTexture(atlas, (Rectangle){ 1, 1, ATLAS_WHITE - 2, ATLAS_WHITE - 2 });
+    loaded = true;
+    return true;
+}
+
+
+/* Call right before CloseWindow(): the shapes texture keeps pointing at the atlas. */
+void glyphs_unload(void) {
+    if(!loaded) return;
+    UnloadTexture(atlas);
+    loaded = false;
+}
+
+
+/* Same spacing rule as DrawText(): one pixel per 10 pixels of font size. */
+float glyphs_measure(const char *text, int fontSize) {
+    const Font *font = font_for(fontSize);
+    if(!font) return (float)MeasureText(text, fontSize);
+    return MeasureTextEx(*font, text, (float)fontSize, (float)(fontSize / 10)).x;
+}
+
+
+void glyphs_draw(const char *text, float x, float y, int fontSize, Color color) {
+    const Font *font = font_for(fontSize);
+    if(!font) {
+        DrawText(text, (int)x, (int)y, fontSize, color);
+        return;
+    }
+    DrawTextEx(*font, text, (Vector2){ x, y }, (float)fontSize, (float)(fontSize / 10), color);
+}
@@ -0,0 +1,27 @@
+/***********************************************************************************************************************
+ * @author Christian Reiswich
+ * @date 18 Oct. 2026
+ * @version 1.0
+ * @brief Raylib Calculator
+ * @details The default raylib font, pre-scaled at startup to the sizes the buttons and the display use and packed
+ *          into one texture together with a white block that also serves as the shapes texture. Text is then
+ *          drawn 1:1 without per-glyph scaling, and rectangles and labels share a single draw batch.
+ **********************************************************************************************************************/
+
+#ifndef RAYLIBPROJEKT_GLYPHS_H
+#define RAYLIBPROJEKT_GLYPHS_H
+
+#pragma once
+#include "raylib.h"
+#include <stdbool.h>
+
+#define GLYPH_LABEL_SIZE   40
+#define GLYPH_DISPLAY_SIZE 48
+
+bool  glyphs_load   (void);
+void  glyphs_unload (void);
+float glyphs_measure(const char *text, int fontSize);
+void  glyphs_draw   (const char *text, float x, float y, int fontSize, Color color);
+
+
+#endif //RAYLIBPROJEKT_GLYPHS_H
@@ -0,0 +1,386 @@
+/***********************************************************************************************************************
+ * @author Christian Reiswich
+ * @date 18 Oct. 2026
+ * @version 1.0
+ * @brief Raylib Calculator
+ * @details
+ **********************************************************************************************************************/
+
+#include "history.h"
+#include "numfmt.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define HISTORY_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define HISTORY_INITIAL 4096    // entries of a new tape
+
+
+static void header_init(HistoryHeader *header) {
+    memset(header, 0, sizeof(*header));
+    memcpy(header->magic, HISTORY_MAGIC, sizeof(header->magic));
+    header->version   = HISTORY_VERSION;
+    header->entrySize = sizeof(HistoryEntry);
+}
+
+
+static bool header_valid(const HistoryHeader *header) {
+    return memcmp(header->magic, HISTORY_MAGIC, sizeof(header->magic)) == 0 && header->version == HISTORY_VERSION
+           && header->entrySize == sizeof(HistoryEntry);
+}
+
+
+#ifdef HISTORY_MMAP
+static size_t file_size_for(uint64_t capacity) {
+    return sizeof(HistoryHeader) + (size_t)capacity * sizeof(HistoryEntry);
+}
+
+
+static bool map_tape(History *h, size_t size) {
+    void *map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, h->fd, 0);
+    if(map == MAP_FAILED) return false;
+
+    if(h->map) munmap(h->map, h->mapSize);
+    h->map      = map;
+    h->mapSize  = size;
+    h->header   = map;
+    h->entries  = (HistoryEntry *)((char *)map + sizeof(HistoryHeader));
+    h->capacity = (size - sizeof(HistoryHeader)) / sizeof(HistoryEntry);
+    return true;
+}
+
+
+static bool open_file(History *h, const char *path) {
+    h->fd = open(path, O_RDWR | O_CREAT, 0644);
+    if(h->fd < 0) return false;
+
+    struct stat st;
+    if(fstat(h->fd, &st) != 0) return false;
+
+    if(st.st_size == 0) {
+        size_t size = file_size_for(HISTORY_INITIAL);
+        if(ftruncate(h->fd, (off_t)size) != 0 || !map_tape(h, size)) return false;
+        header_init(h->header);
+        return true;
+    }
+
+    if((size_t)st.st_size < sizeof(HistoryHeader) || !map_tape(h, (size_t)st.st_size)) return false;
+    if(!header_valid(h->header)) return false;
+    // a count beyond the file means it was cut short; keep what is there
+    if(h->header->count > h->capacity) h->header->count = h->capacity;
+    return true;
+}
+
+
+/* Maps the file read-only and never writes it: the header is copied into `local`, where a count beyond the file
+ * is cut down instead. */
+static bool open_file_readonly(History *h, const char *path) {
+    h->fd = open(path, O_RDONLY);
+    if(h->fd < 0) return false;
+
+    struct stat st;
+    if(fstat(h->fd, &st) != 0 || (size_t)st.st_size < sizeof(HistoryHeader)) return false;
+
+    size_t size = (size_t)st.st_size;
+    void *map = mmap(NULL, size, PROT_READ, MAP_SHARED, h->fd, 0);
+    if(map == MAP_FAILED) return false;
+    h->map     = map;
+    h->mapSize = size;
+
+    memcpy(&h->local, map, sizeof(HistoryHeader));
+    if(!header_valid(&h->local)) return false;
+    h->header   = &h->local;
+    h->entries  = (HistoryEntry *)((char *)map + sizeof(HistoryHeader));
+    h->capacity = (size - sizeof(HistoryHeader)) / sizeof(HistoryEntry);
+    h->readOnly = true;
+    if(h->local.count > h->capacity) h->local.count = h->capacity;
+    return true;
+}
+#endif
+
+
+/* Opens or creates the tape at `path`; NULL keeps it in memory. */
+bool history_open(History *h, const char *path) {
+    memset(h, 0, sizeof(*h));
+    h->fd     = -1;
+    h->header = &h->local;
+    header_init(&h->local);
+    if(!path) return true;
+
+#ifdef HISTORY_MMAP
+    if(open_file(h, path)) return true;
+    history_close(h);
+#endif
+    return false;
+}
+
+
+/* For reading an existing tape, e.g. one the auditor may not write: nothing is created, grown or written, and
+ * history_append() fails. */
+bool history_open_readonly(History *h, const char *path) {
+    memset(h, 0, sizeof(*h));
+    h->fd     = -1;
+    h->header = &h->local;
+    header_init(&h->local);
+
+#ifdef HISTORY_MMAP
+    if(open_file_readonly(h, path)) return true;
+    history_close(h);
+#else
+    (void)path;
+#endif
+    return false;
+}
+
+
+bool history_close(History *h) {
+    bool ok = true;
+#ifdef HISTORY_MMAP
+    if(h->map) {
+        if(!h->readOnly && msync(h->map, h->mapSize, MS_SYNC) != 0) ok = false;
+        munmap(h->map, h->mapSize);
+    }
+    if(h->fd >= 0 && close(h->fd) != 0) ok = false;
+#endif
+    if(h->fd < 0) free(h->entries);
+
+    memset(h, 0, sizeof(*h));
+    h->fd     = -1;
+    h->header = &h->local;
+    header_init(&h->local);
+    return ok;
+}
+
+
+static bool grow(History *h) {
+    uint64_t capacity = h->capacity ? h->capacity * 2 : HISTORY_INITIAL;
+
+#ifdef HISTORY_MMAP
+    if(h->fd >= 0) {
+        size_t size = file_size_for(capacity);
+        return ftruncate(h->fd, (off_t)size) == 0 && map_tape(h, size);
+    }
+#endif
+    HistoryEntry *entries = realloc(h->entries, (size_t)capacity * sizeof(HistoryEntry));
+    if(!entries) return false;
+    h->entries  = entries;
+    h->capacity = capacity;
+    return true;
+}
+
+
+static bool reserve(History *h, uint64_t count) {
+    while(count > h->capacity) {
+        if(!grow(h)) return false;
+    }
+    return true;
+}
+
+
+bool history_append(History *h, HistoryValue left, char op, HistoryValue right, HistoryValue result, unsigned flags) {
+    uint64_t count = h->header->count;
+    if(h->readOnly || !reserve(h, count + 1)) return false;
+
+    HistoryEntry *e = &h->entries[count];
+    e->left   = left;
+    e->right  = right;
+    e->result = result;
+    e->time   = (uint32_t)time(NULL);
+    e->op     = op;
+    bool failed = !(flags & HISTORY_RESULT_INT) && isnan(result.d);
+    e->flags  = (uint8_t)(flags | (failed ? HISTORY_ERROR : 0));
+    e->parts  = 0;
+    e->reserved = 0;
+
+    h->header->count = count + 1;
+    return true;
+}
+
+
+static void part_store(HistoryEntry *slot, const Dec *value) {
+    HistoryPart part;
+    memset(&part, 0, sizeof(part));
+    part.flags = HISTORY_PART;
+    if(!value) {
+        part.flags |= HISTORY_ERROR;
+    } else {
+        if(value->limbs) memcpy(part.limbs, value->limbs, value->nlimbs * sizeof(uint32_t));
+        else             memcpy(part.limbs, &value->small, sizeof(value->small));
+        part.exp    = value->exp;
+        part.nlimbs = (uint8_t)value->nlimbs;
+        part.neg    = value->neg;
+    }
+    memcpy(slot, &part, sizeof(part));
+}
+
+
+/* The value of a part, with its limbs in `limbs`; false for a value that could not be read. */
+static bool part_load(const HistoryEntry *slot, Dec *value, uint32_t *limbs) {
+    HistoryPart part;
+    memcpy(&part, slot, sizeof(part));
+    if((part.flags & HISTORY_ERROR) || part.nlimbs > DEC_MAX_LIMBS) return false;
+
+    dec_zero(value);
+    if(part.nlimbs) {
+        memcpy(limbs, part.limbs, part.nlimbs * sizeof(uint32_t));
+        value->limbs  = limbs;
+        value->nlimbs = part.nlimbs;
+    } else {
+        memcpy(&value->small, part.limbs, sizeof(value->small));
+    }
+    value->exp = part.exp;
+    value->neg = part.neg != 0;
+    return true;
+}
+
+
+/* The text the display showed for a part. */
+static void format_part(const HistoryEntry *slot, char *out, size_t cap) {
+    Dec value;
+    uint32_t limbs[DEC_MAX_LIMBS];
+    if(part_load(slot, &value, limbs)) dec_format(out, cap, &value);
+    else                               snprintf(out, cap, "Error");
+}
+
+
+/* A calculation of the decimal backend with its exact values. `right` is NULL when the display could not be read,
+ * `result` when the calculation failed. */
+bool history_append_dec(History *h, const Dec *left, char op, const Dec *right, const Dec *result) {
+    uint64_t count = h->header->count;
+    if(h->readOnly || !reserve(h, count + 1 + HISTORY_PARTS)) return false;
+
+    HistoryEntry *e = &h->entries[count];
+    e->left.d   = dec_to_double(left);
+    e->right.d  = right  ? dec_to_double(right)  : NAN;
+    e->result.d = result ? dec_to_double(result) : NAN;
+    e->time   = (uint32_t)time(NULL);
+    e->op     = op;
+    e->flags  = (uint8_t)(HISTORY_DECIMAL | (result ? 0 : HISTORY_ERROR));
+    e->parts  = HISTORY_PARTS;
+    e->reserved = 0;
+    part_store(e + 1, left);
+    part_store(e + 2, right);
+    part_store(e + 3, result);
+
+    h->header->count = count + 1 + HISTORY_PARTS;
+    return true;
+}
+
+
+static double value_of(const HistoryEntry *e, HistoryValue v, unsigned intFlag) {
+    return (e->flags & intFlag) ? (double)v.i : v.d;
+}
+
+
+/* First entry at or after `from` whose result or one of whose operands lies within `tolerance` of `value`. */
+int64_t history_find_value(const History *h, double value, double tolerance, uint64_t from) {
+    uint64_t count = h->header->count;
+    for(uint64_t i = from; i < count; i++) {
+        const HistoryEntry *e = &h->entries[i];
+        if(e->flags & HISTORY_PART) continue;
+        if(fabs(value_of(e, e->result, HISTORY_RESULT_INT) - value) <= tolerance
+           || fabs(value_of(e, e->left, HISTORY_LEFT_INT) - value) <= tolerance
+           || fabs(value_of(e, e->right, HISTORY_RIGHT_INT) - value) <= tolerance) {
+            return (int64_t)i;
+        }
+    }
+    return -1;
+}
+
+
+static const double pow10Fine[32] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+    1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22, 1e23, 1e24, 1e25, 1e26, 1e27, 1e28, 1e29, 1e30, 1e31
+};
+
+static const double pow10Coarse[19] = {
+    1e-288, 1e-256, 1e-224, 1e-192, 1e-160, 1e-128, 1e-96, 1e-64, 1e-32, 1e0,
+    1e32,   1e64,   1e96,   1e128,  1e160,  1e192,  1e224, 1e256, 1e288
+};
+
+
+/* Whether the shown text of `a` (> 0) can begin with the significant digit `lead`. Only a quick filter in front of
+ * the exact comparison, so it errs on the side of yes: rounding to the display digits may carry into the next
+ * digit or the next decade. */
+static bool may_lead_with(double a, int lead) {
+    if(!(a >= 1e-280 && a < 1e300)) return true;
+
+    int e2;
+    frexp(a, &e2);
+    int k = (int)floor((e2 - 1) * 0.30102999566398120) + 288;
+    double q = a / (pow10Coarse[k / 32] * pow10Fine[k % 32]);
+    if(q >= 10.0) q /= 10.0;
+
+    const double eps = 1e-13;
+    if(q * (1.0 + eps) >= lead && q * (1.0 - eps) < lead + 1) return true;
+    return lead == 1 && q * (1.0 + eps) >= 10.0;
+}
+
+
+/* A value as the display showed it: exact whole numbers with all their digits. */
+static void format_value(const HistoryEntry *e, HistoryValue v, unsigned intFlag, char *out, size_t cap) {
+    if(e->flags & intFlag) numfmt_format_int(out, cap, v.i);
+    else                   numfmt_format(out, cap, v.d, NUMFMT_DISPLAY_DIGITS);
+}
+
+
+/* First entry at or after `from` whose result, as the display shows it, starts with `prefix`. */
+int64_t history_find_prefix(const History *h, const char *prefix, uint64_t from) {
+    size_t len = strlen(prefix);
+    bool negative = (prefix[0] == '-');     // only with a prefix: "" matches every result
+    int lead = 0;
+    for(const char *p = prefix; *p && !lead; p++) {
+        if(*p >= '1' && *p <= '9') lead = *p - '0';
+        else if(*p != '-' && *p != '0' && *p != ',') break;
+    }
+
+    char text[HISTORY_TEXT_LEN];
+    uint64_t count = h->header->count;
+    for(uint64_t i = from; i < count; i++) {
+        const HistoryEntry *e = &h->entries[i];
+        if(e->flags & HISTORY_PART) continue;
+        double r = value_of(e, e->result, HISTORY_RESULT_INT);
+
+        if(e->flags & HISTORY_ERROR) {
+            if(strncmp("Error", prefix, len) == 0 && len <= 5) return (int64_t)i;
+            continue;
+        }
+        if(r != 0.0 && len > 0) {
+            if((r < 0.0) != negative) continue;
+            if(lead && !may_lead_with(fabs(r), lead)) continue;
+        }
+        if(e->flags & HISTORY_DECIMAL) format_part(e + 3, text, sizeof(text));
+        else                           format_value(e, e->result, HISTORY_RESULT_INT, text, sizeof(text));
+        if(strncmp(text, prefix, len) == 0) return (int64_t)i;
+    }
+    return -1;
+}
+
+
+/* "12,5 * 3 = 37,5", or "... = Error". A decimal entry is read from its parts, which follow it on the tape. */
+size_t history_format(const HistoryEntry *e, char *out, size_t cap) {
+    char left[HISTORY_TEXT_LEN], right[HISTORY_TEXT_LEN], result[HISTORY_TEXT_LEN];
+    if(e->flags & HISTORY_DECIMAL) {
+        format_part(e + 1, left,   sizeof(left));
+        format_part(e + 2, right,  sizeof(right));
+        format_part(e + 3, result, sizeof(result));
+    } else {
+        format_value(e, e->left,  HISTORY_LEFT_INT,  left,  sizeof(left));
+        format_value(e, e->right, HISTORY_RIGHT_INT, right, sizeof(right));
+        if(e->flags & HISTORY_ERROR) strcpy(result, "Error");
+        else                         format_value(e, e->result, HISTORY_RESULT_INT, result, sizeof(result));
+    }
+
+    int n = snprintf(out, cap, "%s %c %s = %s", left, e->op, right, result);
+    return (n < 0) ? 0 : ((size_t)n < cap ? (size_t)n : cap - 1);
+}
@@ -0,0 +1,111 @@
+/***********************************************************************************************************************
+ * @author Christian Reiswich
+ * @date 18 Oct. 2026
+ * @version 1.0
+ * @brief Raylib Calculator
+ * @details History tape: every completed calculation (left op right = result) as a fixed 32 byte entry in an
+ *          append-only array. With a path the array is a file mapped with mmap, little endian:
+ *
+ *            HistoryHeader (64 bytes)
+ *            HistoryEntry  entries[capacity]     the first header.count are in use
+ *
+ *          Each of left, right and result is a double, or an int64_t where its HISTORY_*_INT flag says so: whole
+ *          numbers the double backend computed exactly keep all their digits, also beyond 2^53.
+ *
+ *          A calculation of the decimal backend is followed by HISTORY_PARTS entries of the same size that hold
+ *          its left operand, right operand and result exactly (HistoryPart); its own doubles are only rounded
+ *          copies for history_find_value(). Parts are never shown on their own, scans step over them.
+ *
+ *          Opening maps the file and reads nothing else, so startup costs the same for ten entries as for
+ *          millions. The file grows by doubling; an entry and its parts are written before the count that makes
+ *          them visible. Without a path, or where there is no mmap, the tape lives in memory only.
+ *
+ *          history_find_value() and history_find_prefix() scan forward from an index and return the next match.
+ **********************************************************************************************************************/
+
+#ifndef RAYLIBPROJEKT_HISTORY_H
+#define RAYLIBPROJEKT_HISTORY_H
+
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "decimal.h"
+
+#define HISTORY_MAGIC      "CALCTAPE"
+#define HISTORY_VERSION    3
+#define HISTORY_TEXT_LEN   64       // longest value history_format() writes, as long as the display
+
+#define HISTORY_ERROR      0x01     // the calculation failed, result is NaN
+#define HISTORY_DECIMAL    0x02     // computed by the decimal backend, the exact values follow in HISTORY_PARTS parts
+#define HISTORY_PART       0x04     // one exact value of the decimal entry before it
+#define HISTORY_LEFT_INT   0x08     // left.i holds the operand, not left.d
+#define HISTORY_RIGHT_INT  0x10
+#define HISTORY_RESULT_INT 0x20
+
+#define HISTORY_PARTS      3
+
+typedef struct {
+    char     magic[8];
+    uint32_t version;
+    uint32_t entrySize;
+    uint64_t count;
+    uint8_t  reserved[40];
+} HistoryHeader;
+
+typedef union {
+    double  d;
+    int64_t i;                      // with the HISTORY_*_INT flag of its field
+} HistoryValue;
+
+typedef struct {
+    HistoryValue left;
+    HistoryValue right;
+    HistoryValue result;
+    uint32_t     time;              // seconds since 1970
+    char         op;
+    uint8_t      flags;
+    uint8_t      parts;             // HistoryPart entries that follow
+    uint8_t      reserved;
+} HistoryEntry;
+
+/* Same size as HistoryEntry and with flags at the same place, so a part is told apart by HISTORY_PART. */
+typedef struct {
+    uint32_t limbs[DEC_MAX_LIMBS];  // Dec coefficient in base 10^9, or with nlimbs == 0 the inline one in [0] and [1]
+    int32_t  exp;
+    uint8_t  nlimbs;
+    uint8_t  flags;                 // HISTORY_PART, plus HISTORY_ERROR for a value that could not be read
+    uint8_t  neg;
+    uint8_t  reserved;
+} HistoryPart;
+
+_Static_assert(sizeof(HistoryPart) == sizeof(HistoryEntry), "a part takes the place of an entry");
+_Static_assert(offsetof(HistoryPart, flags) == offsetof(HistoryEntry, flags), "HISTORY_PART must be at entry flags");
+
+typedef struct {
+    HistoryHeader *header;          // in the mapping, or `local` without a file
+    HistoryEntry  *entries;
+    uint64_t       capacity;
+    void          *map;
+    size_t         mapSize;
+    int            fd;              // -1 without a file
+    bool           readOnly;        // history_open_readonly(): the map is PROT_READ, header points at `local`
+    HistoryHeader  local;
+} History;
+
+bool    history_open         (History *h, const char *path);
+bool    history_open_readonly(History *h, const char *path);
+bool    history_close        (History *h);
+bool    history_append       (History *h, HistoryValue left, char op, HistoryValue right, HistoryValue result,
+                              unsigned flags);
+bool    history_append_dec   (History *h, const Dec *left, char op, const Dec *right, const Dec *result);
+int64_t history_find_value   (const History *h, double value, double tolerance, uint64_t from);
+int64_t history_find_prefix  (const History *h, const char *prefix, uint64_t from);
+size_t  history_format       (const HistoryEntry *e, char *out, size_t cap);
+
+static inline uint64_t history_count(const History *h) {
+    return h->header->count;
+}
+
+
+#endif //RAYLIBPROJEKT_HISTORY_H
@@ -0,0 +1,111 @@
+/***********************************************************************************************************************
+ * @author Christian Reiswich
+ * @date 18 Oct. 2026
+ * @version 1.0
+ * @brief Raylib Calculator
+ * @details
+ **********************************************************************************************************************/
+
+#include "input.h"
+#include "raylib.h"
+
+#include <string.h>
+
+
+void input_init(InputQueue *queue) {
+    memset(queue, 0, sizeof(*queue));
+}
+
+
+bool input_push(InputQueue *queue, char key, double time) {
+    if(queue->head - queue->shown >= INPUT_QUEUE_LEN) {
+        queue->dropped++;
+        return false;
+    }
+    InputEvent *e = &queue->events[queue->head & (INPUT_QUEUE_LEN - 1)];
+    e->time = time;
+    e->key  = key;
+    queue->head++;
+    return true;
+}
+
+
+static char special_key(int key) {
+    switch (key) {
+        case KEY_ENTER:
+        case KEY_KP_ENTER:  return CALC_KEY_EQ;
+        case KEY_BACKSPACE: return CALC_KEY_BACKSPACE;
+        case KEY_ESCAPE:
+        case KEY_DELETE:    return CALC_KEY_AC;
+        default:            return 0;
+    }
+}
+
+
+/* raylib queues typed characters and key presses separately and without times, so everything gets the time of
+ * this poll. Characters come first: within one frame Enter or Backspace almost always follows the digits. */
+void input_poll(InputQueue *queue, double time) {
+    int c;
+    while((c = GetCharPressed()) != 0) {
+        if(c > 0 && c < 128) input_push(queue, (char)c, time);
+    }
+
+    int k;
+    while((k = GetKeyPressed()) != 0) {
+        char key = special_key(k);
+        if(key) input_push(queue, key, time);
+    }
+}
+
+
+/* Hands the queued events to the engine in arrival order, as many as its ring takes. Returns how many. */
+int input_apply(InputQueue *queue, Engine *engine) {
+    int handed = 0;
+    while(queue->applied != queue->head) {
+        const InputEvent *e = &queue->events[queue->applied & (INPUT_QUEUE_LEN - 1)];
+        if(!engine_push(engine, e->key)) break;
+        queue->applied++;
+        handed++;
+    }
+    return handed;
+}
+
+
+/* Call once a frame has been drawn from a snapshot in which the engine had taken `engineKeys` keys. Every key goes
+ * through the engine exactly once, so that count lines up with the queue. */
+void input_frame_done(InputQueue *queue, double time, uint64_t engineKeys) {
+    while(queue->shown != (unsigned)engineKeys && queue->shown != queue->applied) {
+        double latency = time - queue->events[queue->shown & (INPUT_QUEUE_LEN - 1)].time;
+        if(latency < 0.0) latency = 0.0;
+
+        int bin = (int)(latency / INPUT_HIST_STEP);
+        if(bin >= INPUT_HIST_BINS) bin = INPUT_HIST_BINS - 1;
+        queue->hist[bin]++;
+
+        queue->latSum += latency;
+        if(latency > queue->latMax) queue->latMax = latency;
+        queue->count++;
+        queue->shown++;
+    }
+}
+
+
+static double percentile(const InputQueue *queue, double p) {
+    unsigned long long target = (unsigned long long)(p * (double)queue->count);
+    unsigned long long seen = 0;
+    for(int i = 0; i < INPUT_HIST_BINS; i++) {
+        seen += queue->hist[i];
+        if(seen > target) return (i == INPUT_HIST_BINS - 1) ? queue->latMax : (i + 1) * INPUT_HIST_STEP;
+    }
+    return queue->latMax;
+}
+
+
+void input_log_stats(const InputQueue *queue) {
+    if(queue->count == 0) return;
+
+    TraceLog(LOG_INFO, "INPUT: %llu events, %llu dropped", queue->count, queue->dropped);
+    TraceLog(LOG_INFO, "INPUT: latency mean %.2f ms, p50 <= %.1f ms, p99 <= %.1f ms, max %.2f ms",
+             queue->latSum / (double)queue->count * 1e3, percentile(queue, 0.50) * 1e3,
+             percentile(queue, 0.99) * 1e3, queue->latMax * 1e3);
+}
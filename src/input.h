@@ -0,0 +1,49 @@
+/***********************************************************************************************************************
+ * @author Christian Reiswich
+ * @date 18 Oct. 2026
+ * @version 1.0
+ * @brief Raylib Calculator
+ * @details Ordered queue of keystrokes from the keyboard and the keypad. Every event keeps the time it was picked
+ *          up; once a frame shows the engine has taken it (EngineView.keys), the delay goes into a latency
+ *          histogram that is logged on exit.
+ **********************************************************************************************************************/
+
+#ifndef RAYLIBPROJEKT_INPUT_H
+#define RAYLIBPROJEKT_INPUT_H
+
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+#include "engine.h"
+
+#define INPUT_QUEUE_LEN 256         // power of two
+#define INPUT_HIST_BINS 64
+#define INPUT_HIST_STEP 0.0005      // seconds per histogram bin, the last bin takes everything above
+
+typedef struct {
+    double time;
+    char   key;
+} InputEvent;
+
+typedef struct {
+    InputEvent events[INPUT_QUEUE_LEN];
+    unsigned   head;                // next free slot
+    unsigned   applied;             // next event to hand to the engine
+    unsigned   shown;               // next event whose frame is not out yet
+
+    unsigned long long count;
+    unsigned long long dropped;
+    double             latSum;
+    double             latMax;
+    unsigned           hist[INPUT_HIST_BINS];
+} InputQueue;
+
+void input_init      (InputQueue *queue);
+bool input_push      (InputQueue *queue, char key, double time);
+void input_poll      (InputQueue *queue, double time);
+int  input_apply     (InputQueue *queue, Engine *engine);
+void input_frame_done(InputQueue *queue, double time, uint64_t engineKeys);
+void input_log_stats (const InputQueue *queue);
+
+
+#endif //RAYLIBPROJEKT_INPUT_H
@@ -0,0 +1,275 @@
+/***********************************************************************************************************************
+ * @author Christian Reiswich
+ * @date 18 Oct. 2026
+ * @version 1.0
+ * @brief Raylib Calculator
+ * @details Generated function, System V: rdi = vars, rsi = stride (doubles), rdx = out, rcx = count.
+ *
+ *              test rcx, rcx / jz done / shl rsi, 3
+ *          loop:
+ *              <program, result in xmm0>
+ *              movsd [rdx], xmm0 / add rdi, rsi / add rdx, 8 / dec rcx / jnz loop
+ *          done:
+ *              ret
+ *
+ *          The constant pool behind the code holds the masks for NEG and DIV, 0.0, 100.0 and the program constants.
+ **********************************************************************************************************************/
+
+#include "jit.h"
+
+#if defined(__x86_64__) && !defined(_WIN32)
+#define JIT_X86_64 1
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+
+#ifdef JIT_X86_64
+
+#define JIT_MAX_BYTES 12288     // 256 instructions of at most 38 bytes, the loop and the pool
+
+// Offsets in the constant pool, which is 16-byte aligned for the packed masks
+#define POOL_SIGN    0          // sign bit, for NEG
+#define POOL_NANFIX  16         // ~bits(NAN): turns an all-ones lane into the NAN the VM returns
+#define POOL_ZERO    32
+#define POOL_HUNDRED 40
+#define POOL_CONSTS  48
+
+#define XMM_SCRATCH  15
+
+enum {
+    SSE_MOVSD  = 0x10,
+    SSE_MOVAPD = 0x28,
+    SSE_ANDPD  = 0x54,
+    SSE_ORPD   = 0x56,
+    SSE_XORPD  = 0x57,
+    SSE_ADD    = 0x58,
+    SSE_MUL    = 0x59,
+    SSE_SUB    = 0x5C,
+    SSE_DIV    = 0x5E,
+    SSE_CMP    = 0xC2
+};
+
+typedef struct {
+    uint32_t at;                // position of the disp32
+    uint32_t end;               // end of the instruction, RIP points there
+    uint32_t target;            // offset in the pool
+} Fixup;
+
+typedef struct {
+    uint8_t  buf[JIT_MAX_BYTES];
+    uint32_t len;
+    Fixup    fix[EXPR_MAX_CODE * 2];
+    int      fixCount;
+    bool     overflow;
+} Emitter;
+
+
+static void emit(Emitter *e, const uint8_t *bytes, uint32_t n) {
+    if(e->len + n > JIT_MAX_BYTES) {
+        e->overflow = true;
+        return;
+    }
+    memcpy(e->buf + e->len, bytes, n);
+    e->len += n;
+}
+
+
+static void emit_u8(Emitter *e, uint8_t byte) {
+    emit(e, &byte, 1);
+}
+
+
+static void emit_u32(Emitter *e, uint32_t v) {
+    uint8_t b[4] = { (uint8_t)v, (uint8_t)(v >> 8), (uint8_t)(v >> 16), (uint8_t)(v >> 24) };
+    emit(e, b, 4);
+}
+
+
+/* prefix [REX] 0F op: the legacy prefix (F2 scalar double, 66 packed double) has to come before REX. */
+static void emit_opcode(Emitter *e, uint8_t prefix, uint8_t op, int reg, int rm) {
+    emit_u8(e, prefix);
+    if(reg >= 8 || rm >= 8) emit_u8(e, (uint8_t)(0x40 | ((reg >= 8) << 2) | (rm >= 8)));
+    emit_u8(e, 0x0F);
+    emit_u8(e, op);
+}
+
+
+/* op xmm<dst>, xmm<src> */
+static void emit_rr(Emitter *e, uint8_t prefix, uint8_t op, int dst, int src) {
+    emit_opcode(e, prefix, op, dst, src);
+    emit_u8(e, (uint8_t)(0xC0 | ((dst & 7) << 3) | (src & 7)));
+}
+
+
+/* op xmm<dst>, [rip + pool offset], patched once the pool has its place */
+static void emit_rip(Emitter *e, uint8_t prefix, uint8_t op, int dst, uint32_t target, int immBytes) {
+    emit_opcode(e, prefix, op, dst, 0);
+    emit_u8(e, (uint8_t)(((dst & 7) << 3) | 5));
+    if(e->fixCount < (int)(sizeof(e->fix) / sizeof(e->fix[0]))) {
+        e->fix[e->fixCount++] = (Fixup){ e->len, e->len + 4 + (uint32_t)immBytes, target };
+    } else {
+        e->overflow = true;
+    }
+    emit_u32(e, 0);
+}
+
+
+/* movsd xmm<dst>, [rdi + 8 * index] */
+static void emit_load_var(Emitter *e, int dst, int index) {
+    emit_opcode(e, 0xF2, SSE_MOVSD, dst, 0);
+    emit_u8(e, (uint8_t)(0x47 | ((dst & 7) << 3)));
+    emit_u8(e, (uint8_t)(index * 8));
+}
+
+
+/* left = (right != 0.0) ? left / right : NAN, without a branch:
+ *   mask = (right == 0.0) ? ~0 : 0;  left = (left / right) | mask;  left ^= mask & ~bits(NAN) */
+static void emit_div(Emitter *e, int left, int right) {
+    emit_rr (e, 0x66, SSE_MOVAPD, XMM_SCRATCH, right);
+    emit_rip(e, 0xF2, SSE_CMP, XMM_SCRATCH, POOL_ZERO, 1);
+    emit_u8 (e, 0);                                             // predicate EQ
+    emit_rr (e, 0xF2, SSE_DIV, left, right);
+    emit_rr (e, 0x66, SSE_ORPD, left, XMM_SCRATCH);
+    emit_rip(e, 0x66, SSE_ANDPD, XMM_SCRATCH, POOL_NANFIX, 0);
+    emit_rr (e, 0x66, SSE_XORPD, left, XMM_SCRATCH);
+}
+
+
+static bool emit_program(Emitter *e, const ExprProgram *prog) {
+    int depth = 0;
+    for(int i = 0; i < prog->codeLen; i++) {
+        const ExprInsn *in = &prog->code[i];
+        switch (in->op) {
+            case EXPR_OP_CONST:
+                if(depth >= JIT_MAX_STACK) return false;
+                emit_rip(e, 0xF2, SSE_MOVSD, depth++, POOL_CONSTS + 8u * in->arg, 0);
+                break;
+            case EXPR_OP_VAR:
+                if(depth >= JIT_MAX_STACK) return false;
+                emit_load_var(e, depth++, in->arg);
+                break;
+            case EXPR_OP_ADD: depth--; emit_rr(e, 0xF2, SSE_ADD, depth - 1, depth); break;
+            case EXPR_OP_SUB: depth--; emit_rr(e, 0xF2, SSE_SUB, depth - 1, depth); break;
+            case EXPR_OP_MUL: depth--; emit_rr(e, 0xF2, SSE_MUL, depth - 1, depth); break;
+            case EXPR_OP_DIV: depth--; emit_div(e, depth - 1, depth);               break;
+            case EXPR_OP_NEG: emit_rip(e, 0x66, SSE_XORPD, depth - 1, POOL_SIGN, 0);  break;
+            case EXPR_OP_PCT: emit_rip(e, 0xF2, SSE_DIV, depth - 1, POOL_HUNDRED, 0); break;
+            default:          return false;
+        }
+    }
+    if(depth == 0) emit_rr(e, 0x66, SSE_XORPD, 0, 0);          // empty program: 0, like expr_run()
+    return true;
+}
+
+
+static void patch_u32(Emitter *e, uint32_t at, uint32_t v) {
+    e->buf[at]     = (uint8_t)v;
+    e->buf[at + 1] = (uint8_t)(v >> 8);
+    e->buf[at + 2] = (uint8_t)(v >> 16);
+    e->buf[at + 3] = (uint8_t)(v >> 24);
+}
+
+
+static bool assemble(Emitter *e, const ExprProgram *prog) {
+    static const uint8_t prologue[] = {
+        0x48, 0x85, 0xC9,                   // test rcx, rcx
+        0x0F, 0x84, 0, 0, 0, 0,             // jz   done
+        0x48, 0xC1, 0xE6, 0x03              // shl  rsi, 3
+    };
+    static const uint8_t epilogue[] = {
+        0xF2, 0x0F, 0x11, 0x02,             // movsd [rdx], xmm0
+        0x48, 0x01, 0xF7,                   // add   rdi, rsi
+        0x48, 0x83, 0xC2, 0x08,             // add   rdx, 8
+        0x48, 0xFF, 0xC9,                   // dec   rcx
+        0x0F, 0x85                          // jnz   loop (rel32 follows)
+    };
+
+    emit(e, prologue, sizeof(prologue));
+    uint32_t loop = e->len;
+    if(!emit_program(e, prog)) return false;
+    emit(e, epilogue, sizeof(epilogue));
+    emit_u32(e, loop - (e->len + 4));
+    uint32_t done = e->len;
+    emit_u8(e, 0xC3);                                           // ret
+
+    while(!e->overflow && e->len % 16) emit_u8(e, 0xCC);
+    uint32_t pool = e->len;
+
+    uint64_t nanBits;
+    double nan = NAN, hundred = 100.0, zero = 0.0;
+    memcpy(&nanBits, &nan, sizeof(nanBits));
+    uint64_t masks[4] = { 0x8000000000000000ull, 0, ~nanBits, ~nanBits };
+    emit(e, (const uint8_t *)masks, sizeof(masks));
+    emit(e, (const uint8_t *)&zero, sizeof(zero));
+    emit(e, (const uint8_t *)&hundred, sizeof(hundred));
+    emit(e, (const uint8_t *)prog->consts, (uint32_t)(sizeof(double) * (size_t)prog->constCount));
+    if(e->overflow) return false;
+
+    patch_u32(e, 5, done - 9);
+    for(int i = 0; i < e->fixCount; i++) {
+        patch_u32(e, e->fix[i].at, pool + e->fix[i].target - e->fix[i].end);
+    }
+    return true;
+}
+#endif
+
+
+bool jit_available(void) {
+#ifdef JIT_X86_64
+    return true;
+#else
+    return false;
+#endif
+}
+
+
+bool jit_compile(JitProgram *jit, const ExprProgram *prog) {
+    *jit = (JitProgram){ 0 };
+#ifdef JIT_X86_64
+    if(prog->error || prog->maxStack > JIT_MAX_STACK) return false;
+
+    Emitter e;
+    e.len      = 0;
+    e.fixCount = 0;
+    e.overflow = false;
+    if(!assemble(&e, prog)) return false;
+
+    // W^X: written while RW, executable only after mprotect
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t size = (e.len + page - 1) / page * page;
+    void *mem = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(mem == MAP_FAILED) return false;
+    memcpy(mem, e.buf, e.len);
+    if(mprotect(mem, size, PROT_READ | PROT_EXEC) != 0) {
+        munmap(mem, size);
+        return false;
+    }
+
+    jit->mem  = mem;
+    jit->size = size;
+    jit->fn   = (JitFn)mem;
+    return true;
+#else
+    (void)prog;
+    return false;
+#endif
+}
+
+
+void jit_free(JitProgram *jit) {
+#ifdef JIT_X86_64
+    if(jit->mem) munmap(jit->mem, jit->size);
+#endif
+    *jit = (JitProgram){ 0 };
+}
+
+
+void jit_run_batch(const JitProgram *jit, const ExprProgram *prog, const double *vars, size_t stride,
+                   double *out, size_t count) {
+    if(jit && jit->fn) jit->fn(vars, stride, out, count);
+    else               expr_run_batch(prog, vars, stride, out, count);
+}
@@ -0,0 +1,40 @@
+/***********************************************************************************************************************
+ * @author Christian Reiswich
+ * @date 18 Oct. 2026
+ * @version 1.0
+ * @brief Raylib Calculator
+ * @details Translates an ExprProgram into x86-64 machine code for the System V ABI. Stack slot i of the bytecode
+ *          lives in register xmm<i>, constants sit in a pool behind the code and are loaded RIP-relative, and the
+ *          loop over all rows is part of the generated code. Division gives NaN for a zero divisor through a
+ *          branchless blend, exactly like expr_run() and eval().
+ *
+ *          On other targets, or for programs deeper than JIT_MAX_STACK, jit_compile() fails and jit_run_batch()
+ *          falls back to expr_run_batch().
+ **********************************************************************************************************************/
+
+#ifndef RAYLIBPROJEKT_JIT_H
+#define RAYLIBPROJEKT_JIT_H
+
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include "expr.h"
+
+#define JIT_MAX_STACK 15        // xmm15 is scratch
+
+typedef void (*JitFn)(const double *vars, size_t stride, double *out, size_t count);
+
+typedef struct {
+    JitFn  fn;                  // NULL: use the interpreter
+    void  *mem;
+    size_t size;
+} JitProgram;
+
+bool jit_available(void);
+bool jit_compile  (JitProgram *jit, const ExprProgram *prog);
+void jit_free     (JitProgram *jit);
+void jit_run_batch(const JitProgram *jit, const ExprProgram *prog, const double *vars, size_t stride,
+                   double *out, size_t count);
+
+
+#endif //RAYLIBPROJEKT_JIT_H
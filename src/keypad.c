@@ -0,0 +1,156 @@
+/***********************************************************************************************************************
+ * @author Christian Reiswich
+ * @date 18 Oct. 2026
+ * @version 1.0
+ * @brief Raylib Calculator
+ * @details
+ **********************************************************************************************************************/
+
+#include "keypad.h"
+#include "perf.h"
+
+#include <string.h>
+
+
+typedef enum {
+    PAD_KIND_AC,
+    PAD_KIND_SIGN,
+    PAD_KIND_PCT,
+    PAD_KIND_OP,
+    PAD_KIND_NUM,
+    PAD_KIND_OPT,
+    PAD_KIND_DOT,
+    PAD_KIND_EQ
+} KeyKind;
+
+typedef struct {
+    const char *label;
+    char        key;
+    KeyKind     kind;
+} KeyDef;
+
+static const KeyDef layout[KEYPAD_BUTTONS] = {
+    { "AC",  CALC_KEY_AC,   PAD_KIND_AC  }, { "+/-", CALC_KEY_SIGN, PAD_KIND_SIGN },
+    { "%",   CALC_KEY_PCT,  PAD_KIND_PCT }, { "/",   '/',           PAD_KIND_OP   },
+    { "7",   '7',           PAD_KIND_NUM }, { "8",   '8',           PAD_KIND_NUM  },
+    { "9",   '9',           PAD_KIND_NUM }, { "x",   '*',           PAD_KIND_OP   },
+    { "4",   '4',           PAD_KIND_NUM }, { "5",   '5',           PAD_KIND_NUM  },
+    { "6",   '6',           PAD_KIND_NUM }, { "-",   '-',           PAD_KIND_OP   },
+    { "1",   '1',           PAD_KIND_NUM }, { "2",   '2',           PAD_KIND_NUM  },
+    { "3",   '3',           PAD_KIND_NUM }, { "+",   '+',           PAD_KIND_OP   },
+    { "Opt", KEYPAD_KEY_OPT,PAD_KIND_OPT }, { "0",   '0',           PAD_KIND_NUM  },
+    { ",",   ',',           PAD_KIND_DOT }, { "=",   CALC_KEY_EQ,   PAD_KIND_EQ   },
+};
+
+
+static Color kind_color(const Theme *theme, KeyKind kind) {
+    switch (kind) {
+        case PAD_KIND_AC:   return theme->acBase;
+        case PAD_KIND_SIGN: return theme->signBase;
+        case PAD_KIND_PCT:  return theme->pctBase;
+        case PAD_KIND_OP:   return theme->opBase;
+        case PAD_KIND_NUM:  return theme->numBase;
+        case PAD_KIND_OPT:  return theme->optBase;
+        case PAD_KIND_DOT:  return theme->dotBase;
+        default:            return theme->eqBase;
+    }
+}
+
+
+static const Button *keypad_button(const Keypad *pad, int index) {
+    return (index == 0 && pad->showBack) ? &pad->back : &pad->buttons[index];
+}
+
+
+void keypad_init(Keypad *pad, Rectangle area, const Theme *theme) {
+    float w = area.width  / KEYPAD_COLS;
+    float h = area.height / KEYPAD_ROWS;
+
+    for(int i = 0; i < KEYPAD_BUTTONS; i++) {
+        const KeyDef *def = &layout[i];
+        bool dark = (def->kind == PAD_KIND_NUM || def->kind == PAD_KIND_DOT);
+
+        pad->buttons[i] = (Button){
+            .bounds    = (Rectangle){ area.x + (i % KEYPAD_COLS) * w, area.y + (i / KEYPAD_COLS) * h, w, h },
+            .label     = def->label,
+            .baseColor = kind_color(theme, def->kind),
+            .textColor = dark ? theme->txtDark : theme->txtLight,
+            .key       = def->key
+        };
+        btn_measure(&pad->buttons[i]);
+    }
+
+    pad->back       = pad->buttons[0];
+    pad->back.label = "Back";
+    pad->back.key   = CALC_KEY_BACKSPACE;
+    btn_measure(&pad->back);
+
+    pad->area       = area;
+    pad->cache      = LoadRenderTexture((int)area.width, (int)area.height);
+    pad->cacheValid = false;
+    pad->showBack   = false;
+    pad->hot        = -1;
+    pad->hotState   = BTN_IDLE;
+}
+
+
+void keypad_unload(Keypad *pad) {
+    UnloadRenderTexture(pad->cache);
+    pad->cacheValid = false;
+}
+
+
+/* Tracks the button under the mouse and returns the key of a completed click, or 0. */
+char keypad_update(Keypad *pad) {
+    Vector2 mp = GetMousePosition();
+    bool down  = IsMouseButtonDown(MOUSE_LEFT_BUTTON);
+
+    pad->hot      = -1;
+    pad->hotState = BTN_IDLE;
+    if(!CheckCollisionPointRec(mp, pad->area)) return 0;
+
+    for(int i = 0; i < KEYPAD_BUTTONS; i++) {
+        BtnState state = btn_state(keypad_button(pad, i), mp, down);
+        if(state == BTN_IDLE) continue;
+
+        pad->hot      = i;
+        pad->hotState = state;
+        if(IsMouseButtonReleased(MOUSE_LEFT_BUTTON)) return keypad_button(pad, i)->key;
+        return 0;
+    }
+    return 0;
+}
+
+
+/* Call outside BeginDrawing(): re-renders the cached grid if the AC slot changed. */
+void keypad_refresh(Keypad *pad, const EngineView *view) {
+    bool showBack = (strcmp(view->display, "0") != 0) && (strcmp(view->display, "Error") != 0 && view->lastWasEq == false);
+    if(showBack != pad->showBack) {
+        pad->showBack   = showBack;
+        pad->cacheValid = false;
+    }
+    if(pad->cacheValid) return;
+
+    BeginTextureMode(pad->cache);
+    ClearBackground(BLANK);
+    for(int i = 0; i < KEYPAD_BUTTONS; i++) {
+        Button b = *keypad_button(pad, i);
+        b.bounds.x -= pad->area.x;
+        b.bounds.y -= pad->area.y;
+        btn_render(&b, BTN_IDLE);
+    }
+    EndTextureMode();
+    pad->cacheValid = true;
+}
+
+
+void keypad_draw(const Keypad *pad) {
+    // render textures are stored bottom up, hence the negative source height
+    Rectangle src = { 0, 0, (float)pad->cache.texture.width, -(float)pad->cache.texture.height };
+    DrawTextureRec(pad->cache.texture, src, (Vector2){ pad->area.x, pad->area.y }, WHITE);
+    PERF_DRAWS(1);
+
+    if(pad->hot >= 0 && pad->hotState != BTN_IDLE) {
+        btn_render(keypad_button(pad, pad->hot), pad->hotState);
+    }
+}
@@ -0,0 +1,42 @@
+/***********************************************************************************************************************
+ * @author Christian Reiswich
+ * @date 18 Oct. 2026
+ * @version 1.0
+ * @brief Raylib Calculator
+ * @details The 4x5 button grid. All buttons are rendered once into a texture in their idle look; a frame draws
+ *          that texture and, on top of it, only the button under the mouse. The texture is rebuilt only when the
+ *          AC slot switches between "AC" and "Back".
+ **********************************************************************************************************************/
+
+#ifndef RAYLIBPROJEKT_KEYPAD_H
+#define RAYLIBPROJEKT_KEYPAD_H
+
+#pragma once
+#include "raylib.h"
+#include "button.h"
+#include "ui.h"
+
+#define KEYPAD_COLS    4
+#define KEYPAD_ROWS    5
+#define KEYPAD_BUTTONS (KEYPAD_COLS * KEYPAD_ROWS)
+#define KEYPAD_KEY_OPT '\x01'          // returned for the Opt button, not a calculator key
+
+typedef struct {
+    Button          buttons[KEYPAD_BUTTONS];
+    Button          back;           // takes the place of AC while there is something to delete
+    Rectangle       area;
+    RenderTexture2D cache;
+    bool            cacheValid;
+    bool            showBack;
+    int             hot;            // index of the button under the mouse, -1 for none
+    BtnState        hotState;
+} Keypad;
+
+void keypad_init   (Keypad *pad, Rectangle area, const Theme *theme);
+void keypad_unload (Keypad *pad);
+char keypad_update (Keypad *pad);
+void keypad_refresh(Keypad *pad, const EngineView *view);
+void keypad_draw   (const Keypad *pad);
+
+
+#endif //RAYLIBPROJEKT_KEYPAD_H
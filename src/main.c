@@ -7,90 +7,183 @@
  **********************************************************************************************************************/
 
 
-#include <string.h>
 #include "raylib.h"
-#include "button.h"
+#include "engine.h"
+#include "glyphs.h"
+#include "input.h"
+#include "keypad.h"
+#include "perf.h"
+#include "plot.h"
 #include "ui.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <errno.h>
+#include <sys/stat.h>
+#define CALC_DATA_DIR 1
+#endif
+
+
+#ifdef CALC_DATA_DIR
+/* mkdir -p, for a directory only this user may enter. */
+static bool make_dirs(char *path) {
+    for(char *p = path + 1; ; p++) {
+        if(*p != '/' && *p != '\0') continue;
+        char c = *p;
+        *p = '\0';
+        bool ok = mkdir(path, 0700) == 0 || errno == EEXIST;
+        *p = c;
+        if(!ok) return false;
+        if(c == '\0') return true;
+    }
+}
+#endif
+
+
+/* $CALC_HISTORY, or else history.tape in the user's data directory, $XDG_DATA_HOME/calc or ~/.local/share/calc.
+ * NULL keeps the tape in memory, where there is no such directory. */
+static const char *tape_path(char *buf, size_t cap) {
+    const char *path = getenv("CALC_HISTORY");
+    if(path && *path) return path;
+
+#ifdef CALC_DATA_DIR
+    const char *data = getenv("XDG_DATA_HOME");
+    const char *home = getenv("HOME");
+    int n;
+    if(data && data[0] == '/') n = snprintf(buf, cap, "%s/calc", data);
+    else if(home && *home)     n = snprintf(buf, cap, "%s/.local/share/calc", home);
+    else                       return NULL;
+    if(n < 0 || (size_t)n + sizeof("/history.tape") > cap || !make_dirs(buf)) return NULL;
+
+    strcat(buf, "/history.tape");
+    return buf;
+#else
+    (void)buf;
+    (void)cap;
+    return NULL;
+#endif
+}
 
 
 int main(void) {
     InitWindow(400, 640, "Raylib Calculator");
     SetTargetFPS(60);
+    // Nichts animiert sich von selbst: zwischen zwei Eingaben blockiert EndDrawing() statt 60 Mal pro Sekunde zu zeichnen
+    EnableEventWaiting();
 
-    Theme theme = ui_default_theme();
-    Calc calc;
-    calc_init(&calc);
+    // Escape ist AC und soll das Fenster nicht schließen
+    SetExitKey(KEY_NULL);
 
-    Button btnAC   = { .bounds=(Rectangle){0,   140, 100, 100}, .label="AC",  .baseColor=theme.acBase,   .textColor=theme.txtLight};
-    Button btnBack = { .bounds=(Rectangle){0,   140, 100, 100}, .label="Back",.baseColor=theme.acBase,   .textColor=theme.txtLight};
-    Button btnSign = { .bounds=(Rectangle){100, 140, 100, 100}, .label="+/-", .baseColor=theme.signBase, .textColor=theme.txtLight};
-    Button btnPct  = { .bounds=(Rectangle){200, 140, 100, 100}, .label="%",   .baseColor=theme.pctBase,  .textColor=theme.txtLight};
-    Button btnDiv  = { .bounds=(Rectangle){300, 140, 100, 100}, .label="/",   .baseColor=theme.opBase,   .textColor=theme.txtLight};
+    if(!glyphs_load()) TraceLog(LOG_WARNING, "GLYPHS: atlas not available, using DrawText");
 
-    Button btn7    = { .bounds=(Rectangle){0,   240, 100, 100}, .label="7",   .baseColor=theme.numBase,  .textColor=theme.txtDark};
-    Button btn8    = { .bounds=(Rectangle){100, 240, 100, 100}, .label="8",   .baseColor=theme.numBase,  .textColor=theme.txtDark};
-    Button btn9    = { .bounds=(Rectangle){200, 240, 100, 100}, .label="9",   .baseColor=theme.numBase,  .textColor=theme.txtDark};
-    Button btnMul  = { .bounds=(Rectangle){300, 240, 100, 100}, .label="x",   .baseColor=theme.opBase,   .textColor=theme.txtLight};
+    Theme theme = ui_default_theme();
 
-    Button btn4    = { .bounds=(Rectangle){0,   340, 100, 100}, .label="4",   .baseColor=theme.numBase,  .textColor=theme.txtDark};
-    Button btn5    = { .bounds=(Rectangle){100, 340, 100, 100}, .label="5",   .baseColor=theme.numBase,  .textColor=theme.txtDark};
-    Button btn6    = { .bounds=(Rectangle){200, 340, 100, 100}, .label="6",   .baseColor=theme.numBase,  .textColor=theme.txtDark};
-    Button btnMin  = { .bounds=(Rectangle){300, 340, 100, 100}, .label="-",   .baseColor=theme.opBase,   .textColor=theme.txtLight};
+    // Rechenstreifen: jede Rechnung landet in einer gemappten Datei im Datenverzeichnis, beim nächsten Start ist
+    // alles sofort wieder da
+    char pathBuf[4096];
+    const char *tapePath = tape_path(pathBuf, sizeof(pathBuf));
+    History tape;
+    if(!tapePath) {
+        TraceLog(LOG_INFO, "HISTORY: no data directory, keeping the tape in memory");
+        history_open(&tape, NULL);
+    } else if(!history_open(&tape, tapePath)) {
+        TraceLog(LOG_WARNING, "HISTORY: cannot open %s, keeping the tape in memory", tapePath);
+        history_open(&tape, NULL);
+    }
 
-    Button btn1    = { .bounds=(Rectangle){0,   440, 100, 100}, .label="1",   .baseColor=theme.numBase,  .textColor=theme.txtDark};
-    Button btn2    = { .bounds=(Rectangle){100, 440, 100, 100}, .label="2",   .baseColor=theme.numBase,  .textColor=theme.txtDark};
-    Button btn3    = { .bounds=(Rectangle){200, 440, 100, 100}, .label="3",   .baseColor=theme.numBase,  .textColor=theme.txtDark};
-    Button btnPlus = { .bounds=(Rectangle){300, 440, 100, 100}, .label="+",   .baseColor=theme.opBase,   .textColor=theme.txtLight};
+    // Der Rechner läuft in einem eigenen Thread, gezeichnet wird immer der letzte Schnappschuss
+    static Engine engine;
+    if(!engine_start(&engine, &tape)) {
+        TraceLog(LOG_ERROR, "ENGINE: cannot start the calculator thread");
+        history_close(&tape);
+        CloseWindow();
+        return 1;
+    }
+    EngineView view;
 
-    Button btnOpt  = { .bounds=(Rectangle){0,   540, 100, 100}, .label="Opt", .baseColor=theme.optBase,  .textColor=theme.txtLight};
-    Button btn0    = { .bounds=(Rectangle){100, 540, 100, 100}, .label="0",   .baseColor=theme.numBase,  .textColor=theme.txtDark};
-    Button btnDot  = { .bounds=(Rectangle){200, 540, 100, 100}, .label=",",   .baseColor=theme.dotBase,  .textColor=theme.txtDark};
-    Button btnEq   = { .bounds=(Rectangle){300, 540, 100, 100}, .label="=",   .baseColor=theme.eqBase,   .textColor=theme.txtLight};
+    Keypad pad;
+    keypad_init(&pad, (Rectangle){0, 140, 400, 500}, &theme);
 
+    InputQueue input;
+    input_init(&input);
 
-    while(!WindowShouldClose()){
-        BeginDrawing();
-        ClearBackground(theme.bg);
+    Rectangle displayRect = (Rectangle){0, 0, 400, 140};
 
-        Rectangle displayRect = (Rectangle){0, 0, 400, 140};
-        ui_draw_display(&calc, displayRect, 48);
+    // Opt öffnet den Funktionsplotter, Escape oder "Calc" führen zurück
+    PlotView plot;
+    if(!plot_init(&plot, (Rectangle){0, 0, 400, 640}, &theme)) TraceLog(LOG_WARNING, "PLOT: out of memory");
+    bool plotting = false;
 
-        bool showBack = (strcmp(calc.display, "0") != 0) && (strcmp(calc.display, "Error") != 0 && calc.lastWasEq == false);
+#ifdef CALC_PROFILE
+    perf_init(getenv("CALC_TRACE"));
+#endif
 
-        if (showBack) {
-            if (btn_draw(&btnBack)) calc_press_backspace(&calc);
+    while(!WindowShouldClose()){
+        PERF_FRAME_BEGIN();
+        double now = GetTime();
+#ifdef CALC_PROFILE
+        if(IsKeyPressed(KEY_F3)) perf_toggle();
+#endif
+        if(plotting) {
+            PERF_ZONE_BEGIN(plotInput);
+            plotting = plot_update(&plot);
+            PERF_ZONE_END(PERF_PLOT, plotInput);
         } else {
-            if (btn_draw(&btnAC))   calc_press_ac(&calc);
+            input_poll(&input, now);
+            char key = keypad_update(&pad);
+            if(key == KEYPAD_KEY_OPT) plotting = (plot.strip != NULL);
+            else if(key)              input_push(&input, key, now);
         }
 
-        //if(btn_draw(&btnAC))   calc_press_ac(&calc);
-        if(btn_draw(&btnSign)) calc_press_sign(&calc);
-        if(btn_draw(&btnPct))  calc_press_pct(&calc);
+        PERF_ZONE_BEGIN(engineStart);
+        input_apply(&input, &engine);
+        engine_read(&engine, &view);
+        PERF_ZONE_END(PERF_ENGINE, engineStart);
+
+        // Solange der Rechner hinterherhinkt, kommt sein Ergebnis ohne Eingabe an: dann nicht auf Events warten
+        if(input.head != (unsigned)view.keys) DisableEventWaiting();
+        else                                  EnableEventWaiting();
 
-        if(btn_draw(&btnDiv))  calc_press_op(&calc, '/');
-        if(btn_draw(&btnMul))  calc_press_op(&calc, '*');
-        if(btn_draw(&btnMin))  calc_press_op(&calc, '-');
-        if(btn_draw(&btnPlus)) calc_press_op(&calc, '+');
+        PERF_ZONE_BEGIN(refreshStart);
+        keypad_refresh(&pad, &view);
+        PERF_ZONE_END(PERF_KEYPAD, refreshStart);
 
-        if(btn_draw(&btn7)) calc_press_digit(&calc, '7');
-        if(btn_draw(&btn8)) calc_press_digit(&calc, '8');
-        if(btn_draw(&btn9)) calc_press_digit(&calc, '9');
-        if(btn_draw(&btn4)) calc_press_digit(&calc, '4');
-        if(btn_draw(&btn5)) calc_press_digit(&calc, '5');
-        if(btn_draw(&btn6)) calc_press_digit(&calc, '6');
-        if(btn_draw(&btn1)) calc_press_digit(&calc, '1');
-        if(btn_draw(&btn2)) calc_press_digit(&calc, '2');
-        if(btn_draw(&btn3)) calc_press_digit(&calc, '3');
-        if(btn_draw(&btn0)) calc_press_digit(&calc, '0');
+        BeginDrawing();
+        ClearBackground(theme.bg);
 
-        if(btn_draw(&btnDot)) calc_press_comma(&calc);
-        if(btn_draw(&btnEq))  calc_press_eq(&calc);
+        if(plotting) {
+            PERF_ZONE_BEGIN(plotStart);
+            plot_draw(&plot);
+            PERF_ZONE_END(PERF_PLOT, plotStart);
+        } else {
+            PERF_ZONE_BEGIN(displayStart);
+            ui_draw_display(&view, displayRect, GLYPH_DISPLAY_SIZE);
+            PERF_ZONE_END(PERF_DISPLAY, displayStart);
 
-        btn_draw(&btnOpt);
+            PERF_ZONE_BEGIN(keypadStart);
+            keypad_draw(&pad);
+            PERF_ZONE_END(PERF_KEYPAD, keypadStart);
+        }
 
+#ifdef CALC_PROFILE
+        perf_draw_overlay((Rectangle){0, 140, 400, 240}, &input);
+#endif
+        input_frame_done(&input, GetTime(), view.keys);
+        PERF_FRAME_END();
         EndDrawing();
     }
 
+#ifdef CALC_PROFILE
+    perf_shutdown();
+#endif
+    input_log_stats(&input);
+    engine_stop(&engine);
+    history_close(&tape);
+    plot_unload(&plot);
+    keypad_unload(&pad);
+    glyphs_unload();
     CloseWindow();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,791 @@
+/***********************************************************************************************************************
+ * @author Christian Reiswich
+ * @date 18 Oct. 2026
+ * @version 1.0
+ * @brief Raylib Calculator
+ * @details Formatting follows Florian Loitsch's Grisu2 (as in Milo Yip's dtoa): the value and its rounding
+ *          boundaries are scaled by a cached power of ten and digits are generated until they fall inside the
+ *          boundaries, so the output always reads back to the same double. When fewer digits are requested than
+ *          the shortest form needs, the exact binary value is rounded instead (in 128-bit integers, or in the
+ *          decimal digit buffer for extreme exponents), so the result matches printf("%.15g").
+ *
+ *          Parsing takes the exact path (Clinger) when the mantissa fits 53 bits and the power of ten is exact;
+ *          otherwise it falls back to a decimal digit buffer shifted by powers of two, as in Go's strconv.
+ **********************************************************************************************************************/
+
+#include "numfmt.h"
+
+#include <stdint.h>
+#include <string.h>
+#include <float.h>
+#include <math.h>
+
+
+/* ---------------------------------------------------------------------------------------------------------------- */
+/* Decimal digit buffer                                                                                              */
+/* ---------------------------------------------------------------------------------------------------------------- */
+
+#define BIGDEC_DIGITS 800
+#define MAX_SHIFT     60
+
+typedef struct {
+    uint8_t d[BIGDEC_DIGITS];   // digit values, most significant first
+    int     nd;                 // digits used
+    int     dp;                 // position of the decimal point
+    bool    trunc;              // nonzero digits were dropped
+} BigDec;
+
+static void bigdec_trim(BigDec *a) {
+    while(a->nd > 0 && a->d[a->nd - 1] == 0) a->nd--;
+    if(a->nd == 0) a->dp = 0;
+}
+
+
+static void bigdec_rshift(BigDec *a, unsigned k) {
+    int r = 0, w = 0;
+    uint64_t n = 0;
+
+    for(; (n >> k) == 0; r++) {
+        if(r >= a->nd) {
+            if(n == 0) {
+                a->nd = 0;
+                return;
+            }
+            while((n >> k) == 0) {
+                n *= 10;
+                r++;
+            }
+            break;
+        }
+        n = n * 10 + a->d[r];
+    }
+    a->dp -= r - 1;
+
+    uint64_t mask = (1ull << k) - 1;
+    for(; r < a->nd; r++) {
+        uint64_t c = a->d[r];
+        a->d[w++] = (uint8_t)(n >> k);
+        n = (n & mask) * 10 + c;
+    }
+    while(n > 0) {
+        uint64_t dig = n >> k;
+        n &= mask;
+        if(w < BIGDEC_DIGITS) a->d[w++] = (uint8_t)dig;
+        else if(dig > 0) a->trunc = true;
+        n *= 10;
+    }
+
+    a->nd = w;
+    bigdec_trim(a);
+}
+
+
+static void bigdec_lshift(BigDec *a, unsigned k) {
+    int extra = (int)(k / 3) + 1;   // multiplying by 2^k adds at most ceil(k * log10(2)) digits
+
+    if(a->nd + extra > BIGDEC_DIGITS) {
+        for(int i = BIGDEC_DIGITS - extra; i < a->nd; i++) {
+            if(a->d[i]) a->trunc = true;
+        }
+        a->nd = BIGDEC_DIGITS - extra;
+    }
+
+    int w = a->nd + extra - 1;
+    uint64_t n = 0;
+    for(int r = a->nd - 1; r >= 0; r--) {
+        n += (uint64_t)a->d[r] << k;
+        uint64_t quo = n / 10;
+        a->d[w--] = (uint8_t)(n - 10 * quo);
+        n = quo;
+    }
+    while(n > 0) {
+        uint64_t quo = n / 10;
+        a->d[w--] = (uint8_t)(n - 10 * quo);
+        n = quo;
+    }
+
+    int start = w + 1;
+    int nd    = a->nd + extra - start;
+    a->dp += nd - a->nd;
+    memmove(a->d, a->d + start, (size_t)nd);
+    a->nd = nd;
+    bigdec_trim(a);
+}
+
+
+static void bigdec_shift(BigDec *a, int k) {
+    if(a->nd == 0) return;
+    for(; k > MAX_SHIFT; k -= MAX_SHIFT)  bigdec_lshift(a, MAX_SHIFT);
+    for(; k < -MAX_SHIFT; k += MAX_SHIFT) bigdec_rshift(a, MAX_SHIFT);
+    if(k > 0) bigdec_lshift(a, (unsigned)k);
+    if(k < 0) bigdec_rshift(a, (unsigned)-k);
+}
+
+
+static bool bigdec_round_up(const BigDec *a, int nd) {
+    if(nd < 0 || nd >= a->nd) return false;
+    if(a->d[nd] == 5 && nd + 1 == a->nd) {
+        if(a->trunc) return true;
+        return nd > 0 && (a->d[nd - 1] % 2) != 0;
+    }
+    return a->d[nd] >= 5;
+}
+
+
+static uint64_t bigdec_rounded_integer(const BigDec *a) {
+    if(a->dp > 20) return UINT64_MAX;
+
+    uint64_t n = 0;
+    int i = 0;
+    for(; i < a->dp && i < a->nd; i++) n = n * 10 + a->d[i];
+    for(; i < a->dp; i++) n *= 10;
+    if(bigdec_round_up(a, a->dp)) n++;
+    return n;
+}
+
+
+/* ---------------------------------------------------------------------------------------------------------------- */
+/* Formatting                                                                                                        */
+/* ---------------------------------------------------------------------------------------------------------------- */
+
+#define DP_HIDDEN_BIT 0x0010000000000000ull
+#define DP_FRAC_MASK  0x000FFFFFFFFFFFFFull
+
+typedef struct {
+    uint64_t f;
+    int      e;
+} DiyFp;
+
+/* Normalized 10^k for k = -348, -340, ..., 340 */
+static const DiyFp cachedPowers[] = {
+    {0xfa8fd5a0081c0288ull, -1220}, {0xbaaee17fa23ebf76ull, -1193}, {0x8b16fb203055ac76ull, -1166},
+    {0xcf42894a5dce35eaull, -1140}, {0x9a6bb0aa55653b2dull, -1113}, {0xe61acf033d1a45dfull, -1087},
+    {0xab70fe17c79ac6caull, -1060}, {0xff77b1fcbebcdc4full, -1034}, {0xbe5691ef416bd60cull, -1007},
+    {0x8dd01fad907ffc3cull,  -980}, {0xd3515c2831559a83ull,  -954}, {0x9d71ac8fada6c9b5ull,  -927},
+    {0xea9c227723ee8bcbull,  -901}, {0xaecc49914078536dull,  -874}, {0x823c12795db6ce57ull,  -847},
+    {0xc21094364dfb5637ull,  -821}, {0x9096ea6f3848984full,  -794}, {0xd77485cb25823ac7ull,  -768},
+    {0xa086cfcd97bf97f4ull,  -741}, {0xef340a98172aace5ull,  -715}, {0xb23867fb2a35b28eull,  -688},
+    {0x84c8d4dfd2c63f3bull,  -661}, {0xc5dd44271ad3cdbaull,  -635}, {0x936b9fcebb25c996ull,  -608},
+    {0xdbac6c247d62a584ull,  -582}, {0xa3ab66580d5fdaf6ull,  -555}, {0xf3e2f893dec3f126ull,  -529},
+    {0xb5b5ada8aaff80b8ull,  -502}, {0x87625f056c7c4a8bull,  -475}, {0xc9bcff6034c13053ull,  -449},
+    {0x964e858c91ba2655ull,  -422}, {0xdff9772470297ebdull,  -396}, {0xa6dfbd9fb8e5b88full,  -369},
+    {0xf8a95fcf88747d94ull,  -343}, {0xb94470938fa89bcfull,  -316}, {0x8a08f0f8bf0f156bull,  -289},
+    {0xcdb02555653131b6ull,  -263}, {0x993fe2c6d07b7facull,  -236}, {0xe45c10c42a2b3b06ull,  -210},
+    {0xaa242499697392d3ull,  -183}, {0xfd87b5f28300ca0eull,  -157}, {0xbce5086492111aebull,  -130},
+    {0x8cbccc096f5088ccull,  -103}, {0xd1b71758e219652cull,   -77}, {0x9c40000000000000ull,   -50},
+    {0xe8d4a51000000000ull,   -24}, {0xad78ebc5ac620000ull,     3}, {0x813f3978f8940984ull,    30},
+    {0xc097ce7bc90715b3ull,    56}, {0x8f7e32ce7bea5c70ull,    83}, {0xd5d238a4abe98068ull,   109},
+    {0x9f4f2726179a2245ull,   136}, {0xed63a231d4c4fb27ull,   162}, {0xb0de65388cc8ada8ull,   189},
+    {0x83c7088e1aab65dbull,   216}, {0xc45d1df942711d9aull,   242}, {0x924d692ca61be758ull,   269},
+    {0xda01ee641a708deaull,   295}, {0xa26da3999aef774aull,   322}, {0xf209787bb47d6b85ull,   348},
+    {0xb454e4a179dd1877ull,   375}, {0x865b86925b9bc5c2ull,   402}, {0xc83553c5c8965d3dull,   428},
+    {0x952ab45cfa97a0b3ull,   455}, {0xde469fbd99a05fe3ull,   481}, {0xa59bc234db398c25ull,   508},
+    {0xf6c69a72a3989f5cull,   534}, {0xb7dcbf5354e9beceull,   561}, {0x88fcf317f22241e2ull,   588},
+    {0xcc20ce9bd35c78a5ull,   614}, {0x98165af37b2153dfull,   641}, {0xe2a0b5dc971f303aull,   667},
+    {0xa8d9d1535ce3b396ull,   694}, {0xfb9b7cd9a4a7443cull,   720}, {0xbb764c4ca7a44410ull,   747},
+    {0x8bab8eefb6409c1aull,   774}, {0xd01fef10a657842cull,   800}, {0x9b10a4e5e9913129ull,   827},
+    {0xe7109bfba19c0c9dull,   853}, {0xac2820d9623bf429ull,   880}, {0x80444b5e7aa7cf85ull,   907},
+    {0xbf21e44003acdd2dull,   933}, {0x8e679c2f5e44ff8full,   960}, {0xd433179d9c8cb841ull,   986},
+    {0x9e19db92b4e31ba9ull,  1013}, {0xeb96bf6ebadf77d9ull,  1039}, {0xaf87023b9bf0ee6bull,  1066},
+};
+
+static const uint32_t pow10u32[] = {
+    1u, 10u, 100u, 1000u, 10000u, 100000u, 1000000u, 10000000u, 100000000u, 1000000000u
+};
+
+
+static DiyFp diy_from_double(double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    int biased = (int)((bits >> 52) & 0x7FF);
+    DiyFp r;
+    if(biased != 0) {
+        r.f = (bits & DP_FRAC_MASK) + DP_HIDDEN_BIT;
+        r.e = biased - 1075;
+    } else {
+        r.f = bits & DP_FRAC_MASK;
+        r.e = 1 - 1075;
+    }
+    return r;
+}
+
+
+static DiyFp diy_normalize(DiyFp x) {
+    int shift = __builtin_clzll(x.f);
+    x.f <<= shift;
+    x.e  -= shift;
+    return x;
+}
+
+
+static DiyFp diy_mul(DiyFp x, DiyFp y) {
+    DiyFp r;
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 p = (unsigned __int128)x.f * y.f;
+    r.f = (uint64_t)(p >> 64) + (((uint64_t)p >> 63) & 1u);
+#else
+    const uint64_t m32 = 0xFFFFFFFFu;
+    uint64_t a = x.f >> 32, b = x.f & m32, c = y.f >> 32, d = y.f & m32;
+    uint64_t ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+    uint64_t tmp = (bd >> 32) + (ad & m32) + (bc & m32) + (1u << 31);
+    r.f = ac + (ad >> 32) + (bc >> 32) + (tmp >> 32);
+#endif
+    r.e = x.e + y.e + 64;
+    return r;
+}
+
+
+static void diy_boundaries(DiyFp v, DiyFp *minus, DiyFp *plus) {
+    DiyFp pl = { (v.f << 1) + 1, v.e - 1 };
+    pl = diy_normalize(pl);
+
+    DiyFp mi;
+    if(v.f == DP_HIDDEN_BIT) {
+        mi.f = (v.f << 2) - 1;
+        mi.e = v.e - 2;
+    } else {
+        mi.f = (v.f << 1) - 1;
+        mi.e = v.e - 1;
+    }
+    mi.f <<= mi.e - pl.e;
+    mi.e   = pl.e;
+
+    *minus = mi;
+    *plus  = pl;
+}
+
+
+static DiyFp cached_power(int e, int *K) {
+    double dk = (-61 - e) * 0.30102999566398114 + 347;
+    int k = (int)dk;
+    if(dk - k > 0.0) k++;
+
+    unsigned index = (unsigned)((k >> 3) + 1);
+    *K = -(-348 + (int)(index << 3));
+    return cachedPowers[index];
+}
+
+
+static int count_digits(uint32_t n) {
+    int digits = 1;
+    while(digits < 10 && n >= pow10u32[digits]) digits++;
+    return digits;
+}
+
+
+static void grisu_round(char *buffer, int len, uint64_t delta, uint64_t rest, uint64_t tenKappa, uint64_t wpw) {
+    while(rest < wpw && delta - rest >= tenKappa &&
+          (rest + tenKappa < wpw || wpw - rest > rest + tenKappa - wpw)) {
+        buffer[len - 1]--;
+        rest += tenKappa;
+    }
+}
+
+
+static int digit_gen(DiyFp w, DiyFp mp, uint64_t delta, char *buffer, int *K) {
+    const DiyFp one = { 1ull << -mp.e, mp.e };
+    const uint64_t wpw = mp.f - w.f;
+
+    uint32_t p1 = (uint32_t)(mp.f >> -one.e);
+    uint64_t p2 = mp.f & (one.f - 1);
+    int kappa = count_digits(p1);
+    int len = 0;
+
+    while(kappa > 0) {
+        uint32_t div = pow10u32[kappa - 1];
+        uint32_t d = p1 / div;
+        p1 %= div;
+        if(d || len) buffer[len++] = (char)('0' + d);
+        kappa--;
+
+        uint64_t rest = ((uint64_t)p1 << -one.e) + p2;
+        if(rest <= delta) {
+            *K += kappa;
+            grisu_round(buffer, len, delta, rest, (uint64_t)pow10u32[kappa] << -one.e, wpw);
+            return len;
+        }
+    }
+
+    for(;;) {
+        p2    *= 10;
+        delta *= 10;
+        char d = (char)(p2 >> -one.e);
+        if(d || len) buffer[len++] = (char)('0' + d);
+        p2 &= one.f - 1;
+        kappa--;
+
+        if(p2 < delta) {
+            *K += kappa;
+            int index = -kappa;
+            grisu_round(buffer, len, delta, p2, one.f, wpw * (index < 10 ? pow10u32[index] : 0));
+            return len;
+        }
+    }
+}
+
+
+/* Shortest digits of a positive finite value: value ~= digits * 10^K. Returns the digit count (at most 17). */
+static int grisu2(double value, char *digits, int *K) {
+    DiyFp v = diy_from_double(value);
+    DiyFp wm, wp;
+    diy_boundaries(v, &wm, &wp);
+
+    DiyFp c  = cached_power(wp.e, K);
+    DiyFp w  = diy_mul(diy_normalize(v), c);
+    DiyFp Wp = diy_mul(wp, c);
+    DiyFp Wm = diy_mul(wm, c);
+    Wm.f++;
+    Wp.f--;
+    return digit_gen(w, Wp, Wp.f - Wm.f, digits, K);
+}
+
+
+static const uint64_t pow10u64[] = {
+    1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull, 1000000000ull,
+    10000000000ull, 100000000000ull, 1000000000000ull, 10000000000000ull, 100000000000000ull,
+    1000000000000000ull, 10000000000000000ull, 100000000000000000ull, 1000000000000000000ull,
+    10000000000000000000ull
+};
+
+
+/* q = f * 2^e * 10^s rounded half-even, done exactly in 128 bits. Fails when the operands do not fit. */
+static bool scaled_round(uint64_t f, int e, int s, uint64_t *q) {
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 n, rem, half;
+
+    if(s >= 0) {
+        if(s > 19 || e > 0) return false;
+        n = (unsigned __int128)f * pow10u64[s];
+        if(e == 0) {
+            *q = (uint64_t)n;
+            return (n >> 64) == 0;
+        }
+        int k = -e;
+        if(k > 127) return false;
+        unsigned __int128 quo = n >> k;
+        rem  = n & ((((unsigned __int128)1) << k) - 1);
+        half = ((unsigned __int128)1) << (k - 1);
+        if((quo >> 64) != 0) return false;
+        *q = (uint64_t)quo;
+    } else {
+        if(-s > 19 || e < 0 || e > 74) return false;
+        n = (unsigned __int128)f << e;
+        unsigned __int128 d = pow10u64[-s];
+        unsigned __int128 quo = n / d;
+        rem  = (n - quo * d) * 2;
+        half = d;
+        if((quo >> 64) != 0) return false;
+        *q = (uint64_t)quo;
+    }
+    if(rem > half || (rem == half && (*q & 1u))) (*q)++;
+    return true;
+#else
+    (void)f; (void)e; (void)s; (void)q;
+    return false;
+#endif
+}
+
+
+/* The first `count` digits of the exact value rounded half-even, as printf does. `exp10` is the decimal exponent
+ * of the leading digit taken from the shortest digits; it may be one off next to a power of ten. */
+static int round_exact(double value, int count, int exp10, char *digits, int *K) {
+    DiyFp v = diy_from_double(value);
+
+    for(int attempt = 0; attempt < 3; attempt++) {
+        uint64_t q;
+        if(!scaled_round(v.f, v.e, count - 1 - exp10, &q)) break;
+        if(q >= pow10u64[count])     { exp10++; continue; }
+        if(q <  pow10u64[count - 1]) { exp10--; continue; }
+
+        for(int i = count - 1; i >= 0; i--) {
+            digits[i] = (char)('0' + q % 10);
+            q /= 10;
+        }
+        *K = exp10 - count + 1;
+        return count;
+    }
+
+    BigDec a;
+    a.nd    = 0;
+    a.trunc = false;
+    for(uint64_t f = v.f; f; f /= 10) a.nd++;
+    uint64_t f = v.f;
+    for(int i = a.nd - 1; i >= 0; i--) {
+        a.d[i] = (uint8_t)(f % 10);
+        f /= 10;
+    }
+    a.dp = a.nd;
+    bigdec_trim(&a);
+    bigdec_shift(&a, v.e);
+
+    bool up = bigdec_round_up(&a, count);
+    for(int i = 0; i < count; i++) digits[i] = (char)('0' + ((i < a.nd) ? a.d[i] : 0));
+    *K = a.dp - count;
+
+    for(int i = count - 1; up && i >= 0; i--) {
+        if(digits[i] == '9') {
+            digits[i] = '0';
+        } else {
+            digits[i]++;
+            up = false;
+        }
+    }
+    if(up) {
+        digits[0] = '1';
+        (*K)++;
+    }
+    return count;
+}
+
+
+static size_t put_exponent(char *p, int exp) {
+    size_t n = 0;
+    p[n++] = 'e';
+    p[n++] = (exp < 0) ? '-' : '+';
+    if(exp < 0) exp = -exp;
+    if(exp >= 100) p[n++] = (char)('0' + exp / 100);
+    p[n++] = (char)('0' + exp / 10 % 10);
+    p[n++] = (char)('0' + exp % 10);
+    return n;
+}
+
+
+static size_t format_into(char *out, double value, int maxDigits) {
+    size_t n = 0;
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    if(value != value) {
+        memcpy(out, "nan", 4);
+        return 3;
+    }
+    if(bits >> 63) {
+        out[n++] = '-';
+        value = -value;
+    }
+    if(value == 0.0) {
+        out[n++] = '0';
+        out[n] = '\0';
+        return n;
+    }
+    if(value > DBL_MAX) {
+        memcpy(out + n, "inf", 4);
+        return n + 3;
+    }
+
+    char digits[24];
+    int K;
+    int len = grisu2(value, digits, &K);
+
+    if(maxDigits < 1) maxDigits = 1;
+    if(len > maxDigits || (value < DBL_MIN && maxDigits < NUMFMT_ROUNDTRIP_DIGITS)) {
+        len = round_exact(value, maxDigits, len + K - 1, digits, &K);
+    }
+    while(len > 1 && digits[len - 1] == '0') {
+        len--;
+        K++;
+    }
+
+    int exp = len + K - 1;
+    if(exp < -4 || exp >= maxDigits) {
+        out[n++] = digits[0];
+        if(len > 1) {
+            out[n++] = ',';
+            memcpy(out + n, digits + 1, (size_t)(len - 1));
+            n += (size_t)(len - 1);
+        }
+        n += put_exponent(out + n, exp);
+    } else if(exp < 0) {
+        out[n++] = '0';
+        out[n++] = ',';
+        for(int i = -1; i > exp; i--) out[n++] = '0';
+        memcpy(out + n, digits, (size_t)len);
+        n += (size_t)len;
+    } else {
+        int whole = exp + 1;
+        if(len <= whole) {
+            memcpy(out + n, digits, (size_t)len);
+            n += (size_t)len;
+            for(int i = len; i < whole; i++) out[n++] = '0';
+        } else {
+            memcpy(out + n, digits, (size_t)whole);
+            n += (size_t)whole;
+            out[n++] = ',';
+            memcpy(out + n, digits + whole, (size_t)(len - whole));
+            n += (size_t)(len - whole);
+        }
+    }
+
+    out[n] = '\0';
+    return n;
+}
+
+
+size_t numfmt_format(char *outStr, size_t cap, double value, int maxDigits) {
+    if(cap == 0) return 0;
+    if(maxDigits > NUMFMT_ROUNDTRIP_DIGITS) maxDigits = NUMFMT_ROUNDTRIP_DIGITS;
+    if(cap >= NUMFMT_MAX_LEN) return format_into(outStr, value, maxDigits);
+
+    char tmp[NUMFMT_MAX_LEN];
+    size_t strLength = format_into(tmp, value, maxDigits);
+    if(strLength + 1 > cap) strLength = cap - 1;
+
+    memcpy(outStr, tmp, strLength);
+    outStr[strLength] = '\0';
+    return strLength;
+}
+
+
+/* ---------------------------------------------------------------------------------------------------------------- */
+/* Parsing                                                                                                           */
+/* ---------------------------------------------------------------------------------------------------------------- */
+
+static const double exactPow10[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+static const int powtab[] = { 1, 3, 6, 9, 13, 16, 19, 23, 26 };
+
+
+static uint64_t bigdec_to_bits(BigDec *a) {
+    const int bias = -1023, mantBits = 52, expMax = 0x7FF;
+    const uint64_t infBits = (uint64_t)expMax << mantBits;
+
+    if(a->nd == 0 || a->dp < -330) return 0;
+    if(a->dp > 310) return infBits;
+
+    int exp = 0;
+    while(a->dp > 0) {
+        int n = (a->dp >= 9) ? 27 : powtab[a->dp];
+        bigdec_shift(a, -n);
+        exp += n;
+    }
+    while(a->dp < 0 || (a->dp == 0 && a->d[0] < 5)) {
+        int n = (-a->dp >= 9) ? 27 : powtab[-a->dp];
+        bigdec_shift(a, n);
+        exp -= n;
+    }
+
+    exp--;   // the digits are in [0.5, 1), the significand in [1, 2)
+    if(exp < bias + 1) {
+        int n = bias + 1 - exp;
+        bigdec_shift(a, -n);
+        exp += n;
+    }
+    if(exp - bias >= expMax) return infBits;
+
+    bigdec_shift(a, 1 + mantBits);
+    uint64_t mant = bigdec_rounded_integer(a);
+    if(mant == (2ull << mantBits)) {
+        mant >>= 1;
+        exp++;
+        if(exp - bias >= expMax) return infBits;
+    }
+    if((mant & (1ull << mantBits)) == 0) exp = bias;
+
+    return (mant & ((1ull << mantBits) - 1)) | ((uint64_t)(exp - bias) << mantBits);
+}
+
+
+static bool is_digit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+
+static bool match_word(const char *p, const char *end, const char *word) {
+    for(; *word; p++, word++) {
+        if(p >= end || (*p | 0x20) != *word) return false;
+    }
+    return true;
+}
+
+
+static double slow_path(const char *p, const char *end, int exp10) {
+    BigDec a;
+    a.nd    = 0;
+    a.dp    = 0;
+    a.trunc = false;
+
+    bool seenPoint = false;
+    for(; p < end; p++) {
+        if(*p == ',' || *p == '.') {
+            seenPoint = true;
+            continue;
+        }
+        if(!is_digit(*p)) break;
+
+        uint8_t d = (uint8_t)(*p - '0');
+        if(a.nd == 0 && d == 0) {
+            if(seenPoint) a.dp--;
+            continue;
+        }
+        if(!seenPoint) a.dp++;
+        if(a.nd < BIGDEC_DIGITS) a.d[a.nd++] = d;
+        else if(d) a.trunc = true;
+    }
+    bigdec_trim(&a);
+    if(a.nd == 0) return 0.0;
+
+    if(exp10 >  100000) exp10 =  100000;
+    if(exp10 < -100000) exp10 = -100000;
+    a.dp += exp10;
+
+    uint64_t bits = bigdec_to_bits(&a);
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+
+double numfmt_parse(const char *str, size_t len, size_t *used) {
+    const char *p   = str;
+    const char *end = str + len;
+    if(used) *used = 0;
+
+    while(p < end && (*p == ' ' || *p == '\t')) p++;
+
+    bool neg = false;
+    if(p < end && (*p == '-' || *p == '+')) {
+        neg = (*p == '-');
+        p++;
+    }
+
+    if(p < end && (*p | 0x20) == 'i' && match_word(p, end, "inf")) {
+        p += match_word(p, end, "infinity") ? 8 : 3;
+        if(used) *used = (size_t)(p - str);
+        return neg ? -HUGE_VAL : HUGE_VAL;
+    }
+    if(p < end && (*p | 0x20) == 'n' && match_word(p, end, "nan")) {
+        if(used) *used = (size_t)(p + 3 - str);
+        return neg ? -(double)NAN : (double)NAN;
+    }
+
+    const char *mantStart = p;
+    uint64_t mant  = 0;
+    int digits     = 0;    // significant digits collected in mant
+    int dropped    = 0;    // integer digits that did not fit into mant
+    int fraction   = 0;    // fraction digits collected in mant
+    bool any       = false;
+    bool truncated = false;
+
+    for(; p < end && is_digit(*p); p++) {
+        any = true;
+        if(digits < 19) {
+            mant = mant * 10 + (uint64_t)(*p - '0');
+            if(mant) digits++;
+        } else {
+            dropped++;
+            if(*p != '0') truncated = true;
+        }
+    }
+    if(p < end && (*p == ',' || *p == '.')) {
+        p++;
+        for(; p < end && is_digit(*p); p++) {
+            any = true;
+            if(digits < 19) {
+                mant = mant * 10 + (uint64_t)(*p - '0');
+                if(mant) digits++;
+                fraction++;
+            } else if(*p != '0') {
+                truncated = true;
+            }
+        }
+    }
+    if(!any) return 0.0;
+    const char *mantEnd = p;
+
+    int exp10 = 0;
+    if(p < end && (*p == 'e' || *p == 'E')) {
+        const char *q = p + 1;
+        bool expNeg = false;
+        if(q < end && (*q == '-' || *q == '+')) {
+            expNeg = (*q == '-');
+            q++;
+        }
+        if(q < end && is_digit(*q)) {
+            for(; q < end && is_digit(*q); q++) {
+                if(exp10 < 100000) exp10 = exp10 * 10 + (*q - '0');
+            }
+            if(expNeg) exp10 = -exp10;
+            p = q;
+        }
+    }
+    if(used) *used = (size_t)(p - str);
+
+    double value;
+    int scale = exp10 + dropped - fraction;
+#if FLT_EVAL_METHOD == 0
+    if(!truncated && mant <= (1ull << 53) && scale >= -22 && scale <= 22) {
+        value = (double)mant;
+        if(scale < 0) value /= exactPow10[-scale];
+        else          value *= exactPow10[scale];
+        return neg ? -value : value;
+    }
+#endif
+    if(mant == 0 && !truncated) return neg ? -0.0 : 0.0;
+
+    value = slow_path(mantStart, mantEnd, exp10);
+    return neg ? -value : value;
+}
+
+
+/* ---------------------------------------------------------------------------------------------------------------- */
+/* Whole numbers                                                                                                     */
+/* ---------------------------------------------------------------------------------------------------------------- */
+
+static const char digitPairs[201] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+
+size_t numfmt_format_int(char *outStr, size_t cap, int64_t value) {
+    if(cap == 0) return 0;
+
+    char tmp[24];
+    char *p = tmp + sizeof(tmp);
+    uint64_t u = (value < 0) ? 0 - (uint64_t)value : (uint64_t)value;
+
+    while(u >= 100) {
+        unsigned pair = (unsigned)(u % 100) * 2;
+        u /= 100;
+        *--p = digitPairs[pair + 1];
+        *--p = digitPairs[pair];
+    }
+    if(u >= 10) {
+        *--p = digitPairs[u * 2 + 1];
+        *--p = digitPairs[u * 2];
+    } else {
+        *--p = (char)('0' + u);
+    }
+    if(value < 0) *--p = '-';
+
+    size_t strLength = (size_t)(tmp + sizeof(tmp) - p);
+    if(strLength + 1 > cap) strLength = cap - 1;
+    memcpy(outStr, p, strLength);
+    outStr[strLength] = '\0';
+    return strLength;
+}
+
+
+/* The whole text must be an optional '-' and digits whose value fits int64_t; "-0" is not a whole number here,
+ * as int64_t has no negative zero. */
+bool numfmt_parse_int(const char *str, size_t len, int64_t *value) {
+    const char *p   = str;
+    const char *end = str + len;
+    bool neg = (p < end && *p == '-');
+    if(neg) p++;
+    if(p == end || end - p > 19) return false;
+
+    uint64_t u = 0;
+    for(; p < end; p++) {
+        if(!is_digit(*p)) return false;
+        u = u * 10 + (uint64_t)(*p - '0');    // 19 digits cannot wrap
+    }
+    if(u > (neg ? (uint64_t)INT64_MAX + 1 : (uint64_t)INT64_MAX) || (neg && u == 0)) return false;
+
+    *value = neg ? (int64_t)(0 - u) : (int64_t)u;
+    return true;
+}
@@ -0,0 +1,32 @@
+/***********************************************************************************************************************
+ * @author Christian Reiswich
+ * @date 18 Oct. 2026
+ * @version 1.0
+ * @brief Raylib Calculator
+ * @details Locale independent number text with ',' as decimal separator. numfmt_format() writes the shortest
+ *          digits that read back to the same double (Grisu2), limited to maxDigits significant digits, in the
+ *          layout of printf("%.*g"). numfmt_parse() accepts ',' or '.' and rounds correctly.
+ *
+ *          numfmt_format_int() and numfmt_parse_int() are the whole number counterparts for int64_t: all digits,
+ *          no exponent, two digits per step.
+ **********************************************************************************************************************/
+
+#ifndef RAYLIBPROJEKT_NUMFMT_H
+#define RAYLIBPROJEKT_NUMFMT_H
+
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define NUMFMT_DISPLAY_DIGITS   15   // what the calculator display has always shown
+#define NUMFMT_ROUNDTRIP_DIGITS 17   // enough for every double to read back unchanged
+#define NUMFMT_MAX_LEN          32   // longest text numfmt_format() can produce, including '\0'
+
+size_t numfmt_format    (char *outStr, size_t cap, double value, int maxDigits);
+double numfmt_parse     (const char *str, size_t len, size_t *used);
+size_t numfmt_format_int(char *outStr, size_t cap, int64_t value);
+bool   numfmt_parse_int (const char *str, size_t len, int64_t *value);
+
+
+#endif //RAYLIBPROJEKT_NUMFMT_H
@@ -0,0 +1,160 @@
+/***********************************************************************************************************************
+ * @author Christian Reiswich
+ * @date 18 Oct. 2026
+ * @version 1.0
+ * @brief Raylib Calculator
+ * @details
+ **********************************************************************************************************************/
+
+#include "perf.h"
+
+#ifdef CALC_PROFILE
+#include <stdio.h>
+
+static const char *const zoneNames[PERF_ZONES] = { "engine", "display", "keypad", "plot" };
+
+typedef struct {
+    bool     visible;
+    FILE    *trace;
+    double   origin;                    // trace timestamps are relative to perf_init()
+    bool     firstEvent;
+
+    double   frameStart;
+    int      frameDraws;
+    int      lastDraws;
+    double   lastFrame;
+    unsigned long long frames;
+    unsigned hist[PERF_HIST_BINS];
+
+    double   zoneFrame[PERF_ZONES];     // this frame
+    double   zoneLast [PERF_ZONES];     // last finished frame
+    double   zoneTotal[PERF_ZONES];
+} Perf;
+
+static Perf perf;
+
+
+static void trace_event(const char *name, double start, double end) {
+    if(!perf.trace) return;
+    fprintf(perf.trace, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.1f,\"dur\":%.1f}",
+            perf.firstEvent ? "" : ",\n", name, (start - perf.origin) * 1e6, (end - start) * 1e6);
+    perf.firstEvent = false;
+}
+
+
+void perf_init(const char *tracePath) {
+    perf = (Perf){ 0 };
+    perf.origin     = GetTime();
+    perf.firstEvent = true;
+
+    if(tracePath && tracePath[0]) {
+        perf.trace = fopen(tracePath, "w");
+        if(perf.trace) fputs("[\n", perf.trace);
+        else           TraceLog(LOG_WARNING, "PERF: cannot write trace to %s", tracePath);
+    }
+}
+
+
+void perf_shutdown(void) {
+    if(perf.trace) {
+        fputs("\n]\n", perf.trace);
+        fclose(perf.trace);
+        perf.trace = NULL;
+    }
+    if(perf.frames == 0) return;
+
+    TraceLog(LOG_INFO, "PERF: %llu frames, engine %.1f us, display %.1f us, keypad %.1f us per frame",
+             perf.frames, perf.zoneTotal[PERF_ENGINE] / (double)perf.frames * 1e6,
+             perf.zoneTotal[PERF_DISPLAY] / (double)perf.frames * 1e6,
+             perf.zoneTotal[PERF_KEYPAD] / (double)perf.frames * 1e6);
+}
+
+
+void perf_frame_begin(void) {
+    perf.frameStart = GetTime();
+    perf.frameDraws = 0;
+    for(int z = 0; z < PERF_ZONES; z++) perf.zoneFrame[z] = 0.0;
+}
+
+
+void perf_frame_end(void) {
+    double end = GetTime();
+    double frame = end - perf.frameStart;
+
+    int bin = (int)(frame * 1e3);
+    if(bin >= PERF_HIST_BINS) bin = PERF_HIST_BINS - 1;
+    perf.hist[bin]++;
+    perf.frames++;
+    perf.lastFrame = frame;
+    perf.lastDraws = perf.frameDraws;
+    for(int z = 0; z < PERF_ZONES; z++) {
+        perf.zoneLast[z]   = perf.zoneFrame[z];
+        perf.zoneTotal[z] += perf.zoneFrame[z];
+    }
+    trace_event("frame", perf.frameStart, end);
+}
+
+
+double perf_zone_begin(void) {
+    return GetTime();
+}
+
+
+void perf_zone_end(PerfZone zone, double start) {
+    double end = GetTime();
+    perf.zoneFrame[zone] += end - start;
+    trace_event(zoneNames[zone], start, end);
+}
+
+
+void perf_count_draws(int count) {
+    perf.frameDraws += count;
+}
+
+
+void perf_toggle(void) {
+    perf.visible = !perf.visible;
+}
+
+
+bool perf_visible(void) {
+    return perf.visible;
+}
+
+
+void perf_draw_overlay(Rectangle area, const InputQueue *input) {
+    if(!perf.visible) return;
+
+    DrawRectangleRec(area, (Color){ 0, 0, 0, 200 });
+    int x = (int)area.x + 10;
+    int y = (int)area.y + 8;
+
+    DrawText(TextFormat("frame %.2f ms   draws %d   frames %llu", perf.lastFrame * 1e3, perf.lastDraws, perf.frames),
+             x, y, 10, RAYWHITE);
+    y += 16;
+    for(int z = 0; z < PERF_ZONES; z++) {
+        double mean = perf.frames ? perf.zoneTotal[z] / (double)perf.frames : 0.0;
+        DrawText(TextFormat("%-8s last %7.1f us   mean %7.1f us", zoneNames[z], perf.zoneLast[z] * 1e6, mean * 1e6),
+                 x, y, 10, RAYWHITE);
+        y += 14;
+    }
+    if(input->count) {
+        DrawText(TextFormat("input -> frame  mean %.2f ms   max %.2f ms",
+                            input->latSum / (double)input->count * 1e3, input->latMax * 1e3), x, y, 10, RAYWHITE);
+    }
+    y += 20;
+
+    // Histogramm der Frame-Zeiten, 1 ms pro Balken
+    unsigned peak = 1;
+    for(int i = 0; i < PERF_HIST_BINS; i++) if(perf.hist[i] > peak) peak = perf.hist[i];
+
+    float barWidth  = (area.width - 20) / PERF_HIST_BINS;
+    float maxHeight = area.y + area.height - 20 - y;
+    for(int i = 0; i < PERF_HIST_BINS; i++) {
+        float h = maxHeight * (float)perf.hist[i] / (float)peak;
+        DrawRectangleRec((Rectangle){ x + i * barWidth, y + maxHeight - h, barWidth - 2, h }, ORANGE);
+    }
+    DrawText("0 ms", x, (int)(y + maxHeight + 4), 10, RAYWHITE);
+    DrawText(TextFormat(">%d ms", PERF_HIST_BINS - 1), (int)(x + (PERF_HIST_BINS - 1) * barWidth), (int)(y + maxHeight + 4), 10, RAYWHITE);
+}
+#endif
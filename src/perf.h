@@ -0,0 +1,58 @@
+/***********************************************************************************************************************
+ * @author Christian Reiswich
+ * @date 18 Oct. 2026
+ * @version 1.0
+ * @brief Raylib Calculator
+ * @details Frame profiler: per-zone times, draw commands per frame, a frame time histogram and the input latency,
+ *          shown as an overlay (F3) and optionally written as a Chrome trace (chrome://tracing, Perfetto).
+ *
+ *          Everything here only exists with CALC_PROFILE; without it the PERF_* macros are empty and perf.c is
+ *          an empty translation unit, so release builds carry no cost.
+ **********************************************************************************************************************/
+
+#ifndef RAYLIBPROJEKT_PERF_H
+#define RAYLIBPROJEKT_PERF_H
+
+#pragma once
+
+#ifdef CALC_PROFILE
+#include <stdbool.h>
+#include "raylib.h"
+#include "input.h"
+
+#define PERF_HIST_BINS 16           // 1 ms each, the last one takes everything slower
+
+typedef enum {
+    PERF_ENGINE,
+    PERF_DISPLAY,
+    PERF_KEYPAD,
+    PERF_PLOT,
+    PERF_ZONES
+} PerfZone;
+
+void   perf_init        (const char *tracePath);
+void   perf_shutdown    (void);
+void   perf_frame_begin (void);
+void   perf_frame_end   (void);
+double perf_zone_begin  (void);
+void   perf_zone_end    (PerfZone zone, double start);
+void   perf_count_draws (int count);
+void   perf_toggle      (void);
+bool   perf_visible     (void);
+void   perf_draw_overlay(Rectangle area, const InputQueue *input);
+
+#define PERF_FRAME_BEGIN()          perf_frame_begin()
+#define PERF_FRAME_END()            perf_frame_end()
+#define PERF_ZONE_BEGIN(var)        double var = perf_zone_begin()
+#define PERF_ZONE_END(zone, var)    perf_zone_end(zone, var)
+#define PERF_DRAWS(count)           perf_count_draws(count)
+#else
+#define PERF_FRAME_BEGIN()          ((void)0)
+#define PERF_FRAME_END()            ((void)0)
+#define PERF_ZONE_BEGIN(var)        ((void)0)
+#define PERF_ZONE_END(zone, var)    ((void)0)
+#define PERF_DRAWS(count)           ((void)0)
+#endif
+
+
+#endif //RAYLIBPROJEKT_PERF_H
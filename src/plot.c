@@ -0,0 +1,331 @@
+/***********************************************************************************************************************
+ * @author Christian Reiswich
+ * @date 18 Oct. 2026
+ * @version 1.0
+ * @brief Raylib Calculator
+ * @details
+ **********************************************************************************************************************/
+
+#include "plot.h"
+#include "glyphs.h"
+#include "numfmt.h"
+#include "perf.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PLOT_FIELD_HEIGHT 60
+#define PLOT_BACK_WIDTH   110
+#define PLOT_TEXT_SIZE    20
+#define PLOT_LABEL_SIZE   10
+#define PLOT_MIN_SPAN     1e-9
+#define PLOT_MIN_REL_SPAN 1e-12     // and never narrower than this part of the centre, or the doubles run out
+#define PLOT_MAX_SPAN     1e12
+#define PLOT_MAX_GRID     64        // grid lines per axis at most
+#define PLOT_FAR          1e4f      // screen coordinates are clamped this far outside the area
+
+static const char *const plotDefault = "x*x*x/8 - x";
+
+
+static void set_formula(PlotView *plot) {
+    curve_set(&plot->curve, plot->text);
+}
+
+
+bool plot_init(PlotView *plot, Rectangle bounds, const Theme *theme) {
+    memset(plot, 0, sizeof(*plot));
+    curve_init(&plot->curve);
+
+    plot->field = (Rectangle){ bounds.x, bounds.y, bounds.width - PLOT_BACK_WIDTH, PLOT_FIELD_HEIGHT };
+    plot->area  = (Rectangle){ bounds.x, bounds.y + PLOT_FIELD_HEIGHT, bounds.width, bounds.height - PLOT_FIELD_HEIGHT };
+    plot->back  = (Button){
+        .bounds    = (Rectangle){ bounds.x + bounds.width - PLOT_BACK_WIDTH, bounds.y, PLOT_BACK_WIDTH, PLOT_FIELD_HEIGHT },
+        .label     = "Calc",
+        .baseColor = theme->optBase,
+        .textColor = theme->txtLight,
+    };
+    btn_measure(&plot->back);
+    plot->bg        = theme->bg;
+    plot->lineColor = theme->opBase;
+
+    double aspect = plot->area.height / plot->area.width;
+    plot->xMin = -10.0;
+    plot->xMax =  10.0;
+    plot->yMin = -10.0 * aspect;
+    plot->yMax =  10.0 * aspect;
+
+    plot->stripCap = 4 * (int)plot->area.width + 16;
+    plot->strip    = malloc((size_t)plot->stripCap * sizeof(Vector2));
+    if(!plot->strip) return false;
+
+    strcpy(plot->text, plotDefault);
+    plot->textLen = (int)strlen(plot->text);
+    set_formula(plot);
+    return true;
+}
+
+
+void plot_unload(PlotView *plot) {
+    curve_free(&plot->curve);
+    free(plot->strip);
+    plot->strip = NULL;
+}
+
+
+/* Whether a view of `span` around `center` still has distinct doubles for every pixel and grid line. */
+static bool span_ok(double span, double center) {
+    return span >= PLOT_MIN_SPAN && span >= fabs(center) * PLOT_MIN_REL_SPAN && span <= PLOT_MAX_SPAN;
+}
+
+
+static void zoom(PlotView *plot, Vector2 mouse, double factor) {
+    double spanX = (plot->xMax - plot->xMin) * factor;
+    double spanY = (plot->yMax - plot->yMin) * factor;
+
+    double fx = (mouse.x - plot->area.x) / plot->area.width;
+    double fy = (mouse.y - plot->area.y) / plot->area.height;
+    double cx = plot->xMin + fx * (plot->xMax - plot->xMin);
+    double cy = plot->yMax - fy * (plot->yMax - plot->yMin);
+    if(!span_ok(spanX, cx) || !span_ok(spanY, cy)) return;
+
+    plot->xMin = cx - fx * spanX;
+    plot->xMax = plot->xMin + spanX;
+    plot->yMax = cy + fy * spanY;
+    plot->yMin = plot->yMax - spanY;
+}
+
+
+static void pan(PlotView *plot, Vector2 delta) {
+    double dx = delta.x / plot->area.width  * (plot->xMax - plot->xMin);
+    double dy = delta.y / plot->area.height * (plot->yMax - plot->yMin);
+    if(fabs(plot->xMin - dx) > PLOT_MAX_SPAN || fabs(plot->yMin + dy) > PLOT_MAX_SPAN) return;
+    if(!span_ok(plot->xMax - plot->xMin, (plot->xMin + plot->xMax) * 0.5 - dx)
+       || !span_ok(plot->yMax - plot->yMin, (plot->yMin + plot->yMax) * 0.5 + dy)) return;
+    plot->xMin -= dx;
+    plot->xMax -= dx;
+    plot->yMin += dy;
+    plot->yMax += dy;
+}
+
+
+/* Keyboard and mouse for one frame. Returns false once the user wants the calculator back. */
+bool plot_update(PlotView *plot) {
+    bool edited = false;
+    int c;
+    while((c = GetCharPressed()) != 0) {
+        if(c >= 32 && c < 127 && plot->textLen < PLOT_TEXT_LEN - 1) {
+            plot->text[plot->textLen++] = (char)c;
+            edited = true;
+        }
+    }
+    int k;
+    while((k = GetKeyPressed()) != 0) {
+        if(k == KEY_ESCAPE) return false;
+        if((k == KEY_BACKSPACE) && plot->textLen > 0) {
+            plot->textLen--;
+            edited = true;
+        } else if(k == KEY_DELETE) {
+            plot->textLen = 0;
+            edited = true;
+        }
+    }
+    if(edited) {
+        plot->text[plot->textLen] = '\0';
+        set_formula(plot);
+    }
+
+    Vector2 mouse = GetMousePosition();
+    bool inside = CheckCollisionPointRec(mouse, plot->area);
+    float wheel = GetMouseWheelMove();
+    if(inside && wheel != 0.0f) zoom(plot, mouse, pow(0.85, wheel));
+
+    if(IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) plot->dragging = inside;
+    if(!IsMouseButtonDown(MOUSE_BUTTON_LEFT))   plot->dragging = false;
+    if(plot->dragging) pan(plot, GetMouseDelta());
+
+    return !(CheckCollisionPointRec(mouse, plot->back.bounds) && IsMouseButtonReleased(MOUSE_BUTTON_LEFT));
+}
+
+
+static float screen_x(const PlotView *plot, double x) {
+    return (float)(plot->area.x + (x - plot->xMin) / (plot->xMax - plot->xMin) * plot->area.width);
+}
+
+
+static float screen_y(const PlotView *plot, double y) {
+    double sy = plot->area.y + (plot->yMax - y) / (plot->yMax - plot->yMin) * plot->area.height;
+    if(sy < plot->area.y - PLOT_FAR)                     return plot->area.y - PLOT_FAR;
+    if(sy > plot->area.y + plot->area.height + PLOT_FAR) return plot->area.y + plot->area.height + PLOT_FAR;
+    return (float)sy;
+}
+
+
+static void strip_push(PlotView *plot, Vector2 v) {
+    if(plot->stripLen > 0) {
+        Vector2 prev = plot->strip[plot->stripLen - 1];
+        if(prev.x == v.x && prev.y == v.y) return;
+    }
+    if(plot->stripLen == plot->stripCap) {
+        DrawLineStrip(plot->strip, plot->stripLen, plot->lineColor);
+        PERF_DRAWS(1);
+        plot->strip[0] = plot->strip[plot->stripLen - 1];
+        plot->stripLen = 1;
+    }
+    plot->strip[plot->stripLen++] = v;
+}
+
+
+static void strip_close_column(PlotView *plot) {
+    if(!plot->columnOpen) return;
+    strip_push(plot, plot->first);
+    strip_push(plot, plot->lowFirst ? plot->low  : plot->high);
+    strip_push(plot, plot->lowFirst ? plot->high : plot->low);
+    strip_push(plot, plot->last);
+    plot->columnOpen = false;
+}
+
+
+static void strip_flush(PlotView *plot) {
+    strip_close_column(plot);
+    if(plot->stripLen >= 2) {
+        DrawLineStrip(plot->strip, plot->stripLen, plot->lineColor);
+        PERF_DRAWS(1);
+    }
+    plot->stripLen = 0;
+}
+
+
+/* Collects the samples of one pixel column; the column goes into the strip as first, low, high, last. */
+static void strip_point(PlotView *plot, Vector2 v) {
+    int column = (int)floorf(v.x);
+    if(plot->columnOpen && column == plot->column) {
+        if(v.y > plot->low.y)  { plot->low  = v; plot->lowFirst = false; }
+        if(v.y < plot->high.y) { plot->high = v; plot->lowFirst = true;  }
+        plot->last = v;
+        return;
+    }
+    strip_close_column(plot);
+    plot->column     = column;
+    plot->columnOpen = true;
+    plot->first = plot->last = plot->low = plot->high = v;
+    plot->lowFirst = true;
+}
+
+
+static double grid_step(double span) {
+    double raw = span / 8.0;
+    double mag = pow(10.0, floor(log10(raw)));
+    double norm = raw / mag;
+    return ((norm < 2.0) ? 2.0 : (norm < 5.0) ? 5.0 : 10.0) * mag;
+}
+
+
+/* The grid lines k * step within [min, max], counted in integers so a step too small for the magnitude cannot stall
+ * the loop. An empty range when there are too many or k does not fit an int64_t. */
+static void grid_range(double min, double max, double step, int64_t *first, int64_t *last) {
+    double lo = ceil(min / step);
+    double hi = floor(max / step);
+    *first = 0;
+    *last  = -1;
+    if(!(fabs(lo) < 0x1p62 && fabs(hi) < 0x1p62) || hi - lo > PLOT_MAX_GRID) return;
+    *first = (int64_t)lo;
+    *last  = (int64_t)hi;
+}
+
+
+static void draw_grid(const PlotView *plot) {
+    Color minor = btn_shade(plot->bg, 0.90f);
+    Color axis  = btn_shade(plot->bg, 0.45f);
+    char label[NUMFMT_MAX_LEN];
+    int64_t first, last;
+
+    double step = grid_step(plot->xMax - plot->xMin);
+    grid_range(plot->xMin, plot->xMax, step, &first, &last);
+    for(int64_t k = first; k <= last; k++) {
+        double x = (double)k * step;
+        float sx = screen_x(plot, x);
+        bool zero = (k == 0);
+        DrawLineV((Vector2){ sx, plot->area.y }, (Vector2){ sx, plot->area.y + plot->area.height }, zero ? axis : minor);
+        numfmt_format(label, sizeof(label), zero ? 0.0 : x, 6);
+        DrawText(label, (int)sx + 2, (int)(plot->area.y + plot->area.height) - PLOT_LABEL_SIZE - 2, PLOT_LABEL_SIZE, axis);
+    }
+
+    step = grid_step(plot->yMax - plot->yMin);
+    grid_range(plot->yMin, plot->yMax, step, &first, &last);
+    for(int64_t k = first; k <= last; k++) {
+        double y = (double)k * step;
+        float sy = screen_y(plot, y);
+        bool zero = (k == 0);
+        DrawLineV((Vector2){ plot->area.x, sy }, (Vector2){ plot->area.x + plot->area.width, sy }, zero ? axis : minor);
+        if(zero) continue;
+        numfmt_format(label, sizeof(label), y, 6);
+        DrawText(label, (int)plot->area.x + 2, (int)sy - PLOT_LABEL_SIZE - 1, PLOT_LABEL_SIZE, axis);
+    }
+}
+
+
+static void draw_curve(PlotView *plot) {
+    double span = plot->xMax - plot->xMin;
+    int    level = curve_level_for(plot->area.width / span);
+    double width = ldexp(1.0, level);
+    double firstTile = floor(plot->xMin / width);
+    double lastTile  = floor(plot->xMax / width);
+
+    // one sample beyond each edge, so the line runs out of the area instead of stopping short
+    double margin = span / plot->area.width;
+    plot->samples  = 0;
+    plot->stripLen = 0;
+    plot->columnOpen = false;
+    if(!(fabs(firstTile) < 0x1p62 && fabs(lastTile) < 0x1p62)) return;
+
+    int64_t first = (int64_t)firstTile;
+    int64_t last  = (int64_t)lastTile;
+
+    for(int64_t index = first; index <= last; index++) {
+        const CurveTile *tile = curve_tile(&plot->curve, level, index);
+        if(!tile) break;
+
+        for(int i = 0; i < tile->count; i++) {
+            const CurvePoint *p = &tile->points[i];
+            if(p->x < plot->xMin - margin || p->x > plot->xMax + margin) continue;
+            plot->samples++;
+            if(!isfinite(p->y)) {
+                strip_flush(plot);
+                continue;
+            }
+            strip_point(plot, (Vector2){ screen_x(plot, p->x), screen_y(plot, p->y) });
+        }
+    }
+    strip_flush(plot);
+}
+
+
+void plot_draw(PlotView *plot) {
+    DrawRectangleRec(plot->area, plot->bg);
+    BeginScissorMode((int)plot->area.x, (int)plot->area.y, (int)plot->area.width, (int)plot->area.height);
+    draw_grid(plot);
+    draw_curve(plot);
+    EndScissorMode();
+
+    char stats[64];
+    numfmt_format(stats, sizeof(stats), (double)plot->samples, 15);
+    strcat(stats, " samples");
+    DrawText(stats, (int)(plot->area.x + plot->area.width) - MeasureText(stats, PLOT_LABEL_SIZE) - 4,
+             (int)plot->area.y + 4, PLOT_LABEL_SIZE, GRAY);
+
+    DrawRectangleRec(plot->field, LIGHTGRAY);
+    DrawRectangleLinesEx(plot->field, 2, BLACK);
+    char line[PLOT_TEXT_LEN + 16];
+    strcpy(line, "f(x) = ");
+    strcat(line, plot->text);
+    strcat(line, "_");
+    glyphs_draw(line, plot->field.x + 10, plot->field.y + 10, PLOT_TEXT_SIZE, BLACK);
+    if(!plot->curve.valid && plot->curve.prog.error) {
+        DrawText(plot->curve.prog.error, (int)plot->field.x + 10, (int)(plot->field.y + plot->field.height) - PLOT_LABEL_SIZE - 6,
+                 PLOT_LABEL_SIZE, RED);
+    }
+    PERF_DRAWS(4);
+
+    btn_draw(&plot->back);
+}
@@ -0,0 +1,56 @@
+/***********************************************************************************************************************
+ * @author Christian Reiswich
+ * @date 18 Oct. 2026
+ * @version 1.0
+ * @brief Raylib Calculator
+ * @details Plot view behind the Opt button: y = f(x) for a formula typed on the keyboard (curve.h), panned by
+ *          dragging and zoomed with the mouse wheel. Escape or the Calc button go back to the calculator.
+ *
+ *          Each frame draws the cached tiles of the level that fits the zoom. Samples that share a pixel column
+ *          are reduced to the first, lowest, highest and last of them, so the number of lines stays bounded by
+ *          the width of the view however many samples the tiles hold.
+ **********************************************************************************************************************/
+
+#ifndef RAYLIBPROJEKT_PLOT_H
+#define RAYLIBPROJEKT_PLOT_H
+
+#pragma once
+#include "raylib.h"
+#include "button.h"
+#include "curve.h"
+#include "ui.h"
+
+#define PLOT_TEXT_LEN 96
+
+typedef struct {
+    Curve     curve;
+    char      text[PLOT_TEXT_LEN];  // the formula as typed
+    int       textLen;
+
+    double    xMin, xMax;           // visible part of the plane
+    double    yMin, yMax;
+    Rectangle field;
+    Rectangle area;
+    Button    back;
+    Color     bg;
+    Color     lineColor;
+    bool      dragging;
+
+    Vector2  *strip;                // screen points of the line being built
+    int       stripLen;
+    int       stripCap;
+    int       column;               // pixel column being collected, see strip_point()
+    bool      columnOpen;
+    Vector2   first, last, low, high;
+    bool      lowFirst;
+
+    unsigned long long samples;     // drawn in the last frame
+} PlotView;
+
+bool plot_init  (PlotView *plot, Rectangle bounds, const Theme *theme);
+void plot_unload(PlotView *plot);
+bool plot_update(PlotView *plot);
+void plot_draw  (PlotView *plot);
+
+
+#endif //RAYLIBPROJEKT_PLOT_H
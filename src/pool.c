@@ -0,0 +1,195 @@
+/***********************************************************************************************************************
+ * @author Christian Reiswich
+ * @date 18 Oct. 2026
+ * @version 1.0
+ * @brief Raylib Calculator
+ * @details The deques are short and guarded by one mutex each; tasks are meant to be coarse (thousands of lines),
+ *          so lock traffic stays far below the work itself.
+ **********************************************************************************************************************/
+
+#include "pool.h"
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#define POOL_INITIAL_CAP 64
+
+
+int pool_cpu_count(void) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return (n > 0) ? (int)n : 1;
+}
+
+
+static bool deque_push(PoolWorker *w, PoolTask task) {
+    pthread_mutex_lock(&w->lock);
+    if(w->len == w->cap) {
+        size_t cap = w->cap ? w->cap * 2 : POOL_INITIAL_CAP;
+        PoolTask *tasks = malloc(cap * sizeof(PoolTask));
+        if(!tasks) {
+            pthread_mutex_unlock(&w->lock);
+            return false;
+        }
+        for(size_t i = 0; i < w->len; i++) tasks[i] = w->tasks[(w->head + i) % w->cap];
+        free(w->tasks);
+        w->tasks = tasks;
+        w->cap   = cap;
+        w->head  = 0;
+    }
+    w->tasks[(w->head + w->len) % w->cap] = task;
+    w->len++;
+
+    // Counted while the task is already in the deque, so a worker woken for it always finds it
+    Pool *pool = w->pool;
+    pthread_mutex_lock(&pool->lock);
+    pool->queued++;
+    pthread_cond_signal(&pool->workReady);
+    pthread_mutex_unlock(&pool->lock);
+    pthread_mutex_unlock(&w->lock);
+    return true;
+}
+
+
+/* The owner takes the newest task, thieves the oldest. */
+static bool deque_take(PoolWorker *w, bool steal, PoolTask *task) {
+    bool found = false;
+    pthread_mutex_lock(&w->lock);
+    if(w->len > 0) {
+        if(steal) {
+            *task   = w->tasks[w->head];
+            w->head = (w->head + 1) % w->cap;
+        } else {
+            *task = w->tasks[(w->head + w->len - 1) % w->cap];
+        }
+        w->len--;
+        found = true;
+
+        pthread_mutex_lock(&w->pool->lock);
+        w->pool->queued--;
+        pthread_mutex_unlock(&w->pool->lock);
+    }
+    pthread_mutex_unlock(&w->lock);
+    return found;
+}
+
+
+static bool find_task(PoolWorker *self, PoolTask *task) {
+    Pool *pool = self->pool;
+    if(deque_take(self, false, task)) return true;
+
+    for(int i = 1; i < pool->count; i++) {
+        PoolWorker *victim = &pool->workers[(self->index + i) % pool->count];
+        if(deque_take(victim, true, task)) {
+            self->stolen++;
+            return true;
+        }
+    }
+    return false;
+}
+
+
+static void *worker_main(void *arg) {
+    PoolWorker *self = arg;
+    Pool *pool = self->pool;
+
+    for(;;) {
+        PoolTask task;
+        if(find_task(self, &task)) {
+            task.fn(task.arg);
+
+            pthread_mutex_lock(&pool->lock);
+            if(--pool->pending == 0) pthread_cond_broadcast(&pool->allDone);
+            pthread_mutex_unlock(&pool->lock);
+            continue;
+        }
+
+        pthread_mutex_lock(&pool->lock);
+        while(!pool->stop && pool->queued == 0) pthread_cond_wait(&pool->workReady, &pool->lock);
+        bool stop = pool->stop && pool->queued == 0;
+        pthread_mutex_unlock(&pool->lock);
+        if(stop) return NULL;
+    }
+}
+
+
+/* Stops and joins the first `started` workers; the locks of all count workers were initialised. */
+static void pool_shutdown(Pool *pool, int started) {
+    pthread_mutex_lock(&pool->lock);
+    pool->stop = true;
+    pthread_cond_broadcast(&pool->workReady);
+    pthread_mutex_unlock(&pool->lock);
+
+    for(int i = 0; i < started; i++) pthread_join(pool->workers[i].thread, NULL);
+    for(int i = 0; i < pool->count; i++) {
+        pthread_mutex_destroy(&pool->workers[i].lock);
+        free(pool->workers[i].tasks);
+    }
+    pthread_cond_destroy(&pool->allDone);
+    pthread_cond_destroy(&pool->workReady);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->workers);
+    pool->workers = NULL;
+    pool->count   = 0;
+}
+
+
+/* threads <= 0 means one per online CPU. */
+bool pool_init(Pool *pool, int threads) {
+    if(threads <= 0) threads = pool_cpu_count();
+
+    pool->workers = calloc((size_t)threads, sizeof(PoolWorker));
+    if(!pool->workers) return false;
+    pool->count     = threads;
+    pool->nextQueue = 0;
+    pool->queued    = 0;
+    pool->pending   = 0;
+    pool->stop      = false;
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->workReady, NULL);
+    pthread_cond_init(&pool->allDone, NULL);
+
+    for(int i = 0; i < threads; i++) {
+        PoolWorker *w = &pool->workers[i];
+        pthread_mutex_init(&w->lock, NULL);
+        w->pool  = pool;
+        w->index = i;
+    }
+    for(int i = 0; i < threads; i++) {
+        if(pthread_create(&pool->workers[i].thread, NULL, worker_main, &pool->workers[i]) != 0) {
+            pool_shutdown(pool, i);
+            return false;
+        }
+    }
+    return true;
+}
+
+
+/* Runs the task inline when its deque cannot grow, so a submitted task is never lost. */
+void pool_submit(Pool *pool, PoolFn fn, void *arg) {
+    PoolWorker *w = &pool->workers[pool->nextQueue++ % (unsigned)pool->count];
+
+    pthread_mutex_lock(&pool->lock);
+    pool->pending++;
+    pthread_mutex_unlock(&pool->lock);
+
+    if(!deque_push(w, (PoolTask){ fn, arg })) {
+        fn(arg);
+
+        pthread_mutex_lock(&pool->lock);
+        if(--pool->pending == 0) pthread_cond_broadcast(&pool->allDone);
+        pthread_mutex_unlock(&pool->lock);
+    }
+}
+
+
+void pool_wait(Pool *pool) {
+    pthread_mutex_lock(&pool->lock);
+    while(pool->pending > 0) pthread_cond_wait(&pool->allDone, &pool->lock);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+
+/* Finishes everything already submitted, then joins the workers. */
+void pool_destroy(Pool *pool) {
+    pool_shutdown(pool, pool->count);
+}
@@ -0,0 +1,58 @@
+/***********************************************************************************************************************
+ * @author Christian Reiswich
+ * @date 18 Oct. 2026
+ * @version 1.0
+ * @brief Raylib Calculator
+ * @details Work-stealing thread pool. Every worker owns a deque: it takes its own tasks from the back and, when
+ *          that runs dry, steals from the front of the others. Tasks submitted from outside are dealt out round
+ *          robin. pool_wait() returns once every submitted task has finished.
+ **********************************************************************************************************************/
+
+#ifndef RAYLIBPROJEKT_POOL_H
+#define RAYLIBPROJEKT_POOL_H
+
+#pragma once
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef void (*PoolFn)(void *arg);
+
+typedef struct {
+    PoolFn fn;
+    void  *arg;
+} PoolTask;
+
+typedef struct {
+    pthread_mutex_t lock;
+    PoolTask       *tasks;          // ring of cap entries, head is the front
+    size_t          cap;
+    size_t          head;
+    size_t          len;
+    pthread_t       thread;
+    struct Pool    *pool;
+    int             index;
+    unsigned long long stolen;
+} PoolWorker;
+
+typedef struct Pool {
+    PoolWorker     *workers;
+    int             count;
+    unsigned        nextQueue;      // round robin for pool_submit()
+
+    pthread_mutex_t lock;
+    pthread_cond_t  workReady;
+    pthread_cond_t  allDone;
+    size_t          queued;         // submitted, not yet taken by a worker
+    size_t          pending;        // submitted, not yet finished
+    bool            stop;
+} Pool;
+
+int  pool_cpu_count(void);
+bool pool_init     (Pool *pool, int threads);
+void pool_submit   (Pool *pool, PoolFn fn, void *arg);
+void pool_wait     (Pool *pool);
+void pool_destroy  (Pool *pool);
+
+
+#endif //RAYLIBPROJEKT_POOL_H
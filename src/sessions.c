@@ -0,0 +1,665 @@
+/***********************************************************************************************************************
+ * @author Christian Reiswich
+ * @date 18 Oct. 2026
+ * @version 1.0
+ * @brief Raylib Calculator
+ * @details
+ **********************************************************************************************************************/
+
+#include "sessions.h"
+#include "numfmt.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SESSIONS_INITIAL  1024
+#define SESSIONS_TEXT     64    // like Calc.display
+
+static const char pendingOps[5] = { 0, '+', '-', '*', '/' };
+
+static const double pow10Exact[23] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+
+static SessionKind kind_of(uint16_t state) {
+    return (SessionKind)((state & SESSION_KIND) >> SESSION_KIND_SHIFT);
+}
+
+
+static unsigned scale_of(uint16_t state) {
+    return state >> SESSION_SCALE_SHIFT;
+}
+
+
+static uint16_t with_kind(uint16_t state, SessionKind kind) {
+    return (uint16_t)((state & ~SESSION_KIND) | ((unsigned)kind << SESSION_KIND_SHIFT));
+}
+
+
+/* A typed number: kind, sign and scale replaced, the flags kept. */
+static uint16_t with_number(uint16_t state, bool negative, unsigned scale) {
+    state &= SESSION_PENDING | SESSION_ENTERING | SESSION_AFTER_EQ | SESSION_ACC_EXACT;
+    return (uint16_t)(state | (negative ? SESSION_NEGATIVE : 0) | (scale << SESSION_SCALE_SHIFT));
+}
+
+
+static unsigned pending_index(char op) {
+    switch (op) {
+        case '+': return 1;
+        case '-': return 2;
+        case '*': return 3;
+        case '/': return 4;
+        default:  return 0;
+    }
+}
+
+
+static double bits_to_double(uint64_t bits) {
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+
+static uint64_t double_to_bits(double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+
+/* "-12,50" from magnitude 1250, negative, scale 2. At most 43 characters with SESSIONS_MAX_SCALE. */
+static size_t number_text(char *out, uint64_t magnitude, bool negative, unsigned scale) {
+    char digits[24];
+    char *d = digits + sizeof(digits);
+    do {
+        *--d = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while(magnitude);
+    size_t len = (size_t)(digits + sizeof(digits) - d);
+
+    char *p = out;
+    if(negative) *p++ = '-';
+    if(scale == SESSION_NO_COMMA) {
+        memcpy(p, d, len);
+        p += len;
+    } else if(len > scale) {
+        memcpy(p, d, len - scale);
+        p += len - scale;
+        *p++ = ',';
+        memcpy(p, d + len - scale, scale);
+        p += scale;
+    } else {
+        *p++ = '0';
+        *p++ = ',';
+        memset(p, '0', scale - len);
+        p += scale - len;
+        memcpy(p, d, len);
+        p += len;
+    }
+    *p = '\0';
+    return (size_t)(p - out);
+}
+
+
+/* The display of session `id`; `out` holds SESSIONS_TEXT bytes. */
+static size_t display_text(const Sessions *t, uint32_t id, char *out) {
+    uint16_t state = t->state[id];
+    uint64_t shown = t->shown[id];
+
+    switch (kind_of(state)) {
+        case SESSION_NUMBER:
+            return number_text(out, shown, (state & SESSION_NEGATIVE) != 0, scale_of(state));
+        case SESSION_DOUBLE:
+            format_number(out, SESSIONS_TEXT, bits_to_double(shown));
+            return strlen(out);
+        case SESSION_ERROR:
+            strcpy(out, "Error");
+            return 5;
+        default:
+            strcpy(out, t->spill[shown].display);
+            return strlen(out);
+    }
+}
+
+
+/* The compact form of a display text, into the kind, sign and scale of `state`; false when it has none. */
+static bool pack_text(const char *text, uint16_t *state, uint64_t *shown) {
+    if(strcmp(text, "Error") == 0) {
+        *state = with_kind(with_number(*state, false, 0), SESSION_ERROR);
+        *shown = 0;
+        return true;
+    }
+
+    const char *p = text;
+    bool negative = (*p == '-');
+    if(negative) p++;
+
+    uint64_t magnitude = 0;
+    unsigned scale = SESSION_NO_COMMA;
+    const char *start = p;
+    bool fits = true;
+    for(; *p >= '0' && *p <= '9' && fits; p++) {
+        fits = magnitude <= (UINT64_MAX - 9) / 10;
+        magnitude = magnitude * 10 + (uint64_t)(*p - '0');
+    }
+    if(fits && *p == ',') {
+        for(scale = 0, p++; *p >= '0' && *p <= '9' && fits; p++, scale++) {
+            fits = magnitude <= (UINT64_MAX - 9) / 10 && scale < SESSIONS_MAX_SCALE;
+            magnitude = magnitude * 10 + (uint64_t)(*p - '0');
+        }
+    }
+    // no leading zeros: "0" and "0,5" are numbers as typed, "05" is not
+    if(fits && *p == '\0' && p > start && (start[0] != '0' || start[1] == '\0' || start[1] == ',')) {
+        *state = with_number(*state, negative, scale);
+        *shown = magnitude;
+        return true;
+    }
+
+    // a result as numfmt writes it
+    size_t len = strlen(text), used;
+    double value = numfmt_parse(text, len, &used);
+    char check[NUMFMT_MAX_LEN];
+    if(used != len || len >= sizeof(check)) return false;
+    format_number(check, sizeof(check), value);
+    if(strcmp(check, text) != 0) return false;
+
+    *state = with_kind(with_number(*state, false, 0), SESSION_DOUBLE);
+    *shown = double_to_bits(value);
+    return true;
+}
+
+
+/* The display as an operand, exactly like display_value() in calc.c: a whole number in `whole` when `exact`. */
+static double operand(const Sessions *t, uint32_t id, int64_t *whole, bool *exact) {
+    uint16_t state = t->state[id];
+    uint64_t shown = t->shown[id];
+
+    if(kind_of(state) == SESSION_NUMBER) {
+        bool negative = (state & SESSION_NEGATIVE) != 0;
+        unsigned scale = scale_of(state);
+        if(scale == SESSION_NO_COMMA) {
+            // "-0" and what int64_t cannot hold are left to the text below
+            if(!negative && shown <= (uint64_t)INT64_MAX) {
+                *exact = true;
+                *whole = (int64_t)shown;
+                return (double)*whole;
+            }
+            if(negative && shown != 0 && shown <= (uint64_t)INT64_MAX + 1) {
+                *exact = true;
+                *whole = (int64_t)(0 - shown);
+                return (double)*whole;
+            }
+        } else if(shown <= (1ull << 53) && scale < sizeof(pow10Exact) / sizeof(pow10Exact[0])) {
+            // both exact, so the one rounding of the division is the correct rounding of the text
+            double value = (double)shown / pow10Exact[scale];
+            *exact = false;
+            return negative ? -value : value;
+        }
+    } else if(kind_of(state) == SESSION_DOUBLE) {
+        // whole numbers below 10^15 show all their digits, so their text is the whole number again
+        double value = bits_to_double(shown);
+        if(value == trunc(value) && fabs(value) < 1e15 && !(value == 0.0 && signbit(value))) {
+            *exact = true;
+            *whole = (int64_t)value;
+            return value;
+        }
+    }
+
+    char text[SESSIONS_TEXT];
+    size_t len = display_text(t, id, text);
+    *exact = numfmt_parse_int(text, len, whole);
+    return *exact ? (double)*whole : numfmt_parse(text, len, NULL);
+}
+
+
+static double acc_of(const Sessions *t, uint32_t id, int64_t *whole) {
+    if(t->state[id] & SESSION_ACC_EXACT) {
+        *whole = (int64_t)t->acc[id];
+        return (double)*whole;
+    }
+    *whole = 0;
+    return bits_to_double(t->acc[id]);
+}
+
+
+static void set_acc(Sessions *t, uint32_t id, double value, int64_t whole, bool exact) {
+    t->acc[id] = exact ? (uint64_t)whole : double_to_bits(value);
+    if(exact) t->state[id] |= SESSION_ACC_EXACT;
+    else      t->state[id] &= (uint16_t)~SESSION_ACC_EXACT;
+}
+
+
+/* calc_store_int(): accumulator and display. */
+static void store_whole(Sessions *t, uint32_t id, int64_t value) {
+    bool negative = value < 0;
+    t->shown[id] = negative ? 0 - (uint64_t)value : (uint64_t)value;
+    t->state[id] = with_number(t->state[id], negative, SESSION_NO_COMMA);
+    set_acc(t, id, (double)value, value, true);
+}
+
+
+static void store_double(Sessions *t, uint32_t id, double value) {
+    t->shown[id] = double_to_bits(value);
+    t->state[id] = with_kind(with_number(t->state[id], false, 0), SESSION_DOUBLE);
+    set_acc(t, id, value, 0, false);
+}
+
+
+static void store_error(Sessions *t, uint32_t id) {
+    t->shown[id] = 0;
+    t->state[id] = with_kind(with_number(t->state[id], false, 0), SESSION_ERROR);
+    set_acc(t, id, 0.0, 0, true);
+}
+
+
+static void reset(Sessions *t, uint32_t id) {
+    t->acc[id]   = 0;
+    t->shown[id] = 0;
+    t->state[id] = (uint16_t)(SESSION_ENTERING | SESSION_ACC_EXACT | (SESSION_NO_COMMA << SESSION_SCALE_SHIFT));
+}
+
+
+/* ---------------------------------------------------------------------------------------------------------------- */
+/* Spilled sessions                                                                                                  */
+/* ---------------------------------------------------------------------------------------------------------------- */
+
+static bool spill_take(Sessions *t, uint32_t *slot) {
+    if(t->spillFreeCount) {
+        *slot = t->spillFree[--t->spillFreeCount];
+        return true;
+    }
+    if(t->spillCount == t->spillCap) {
+        uint32_t cap = t->spillCap ? t->spillCap * 2 : 64;
+        Calc *spill = realloc(t->spill, (size_t)cap * sizeof(Calc));
+        if(!spill) return false;
+        t->spill = spill;
+        uint32_t *spillFree = realloc(t->spillFree, (size_t)cap * sizeof(uint32_t));
+        if(!spillFree) return false;
+        t->spillFree = spillFree;
+        t->spillCap  = cap;
+    }
+    *slot = t->spillCount++;
+    return true;
+}
+
+
+static void spill_release(Sessions *t, uint32_t slot) {
+    t->spillFree[t->spillFreeCount++] = slot;
+}
+
+
+static void expand(const Sessions *t, uint32_t id, Calc *calc) {
+    calc_init(calc);
+    calc_set_backend(calc, CALC_BACKEND_DOUBLE);
+
+    uint16_t state = t->state[id];
+    calc->acc         = acc_of(t, id, &calc->accInt);
+    calc->accExact    = (state & SESSION_ACC_EXACT) != 0;
+    calc->pending     = pendingOps[state & SESSION_PENDING];
+    calc->enteringNew = (state & SESSION_ENTERING) != 0;
+    calc->lastWasEq   = (state & SESSION_AFTER_EQ) != 0;
+    display_text(t, id, calc->display);
+}
+
+
+/* Takes the state of `calc` into session `id`, which stays or becomes spilled if the display has no compact form.
+ * `calc` may be the session's own spill slot. */
+static bool pack(Sessions *t, uint32_t id, const Calc *calc) {
+    uint16_t state = (uint16_t)(pending_index(calc->pending) | (calc->enteringNew ? SESSION_ENTERING : 0)
+                                | (calc->lastWasEq ? SESSION_AFTER_EQ : 0) | (calc->accExact ? SESSION_ACC_EXACT : 0));
+    bool spilled = kind_of(t->state[id]) == SESSION_SPILLED;
+    uint32_t slot = (uint32_t)t->shown[id];
+    uint64_t shown;
+
+    if(pack_text(calc->display, &state, &shown)) {
+        if(spilled) spill_release(t, slot);
+    } else {
+        if(!spilled) {
+            if(!spill_take(t, &slot)) {
+                store_error(t, id);
+                return false;
+            }
+            t->spill[slot] = *calc;
+        }
+        state = with_kind(state, SESSION_SPILLED);
+        shown = slot;
+    }
+    t->acc[id]   = calc->accExact ? (uint64_t)calc->accInt : double_to_bits(calc->acc);
+    t->shown[id] = shown;
+    t->state[id] = state;
+    return true;
+}
+
+
+static bool press_calc(Sessions *t, uint32_t id, char key) {
+    if(kind_of(t->state[id]) == SESSION_SPILLED) {
+        Calc *calc = &t->spill[t->shown[id]];
+        bool known = calc_press_key(calc, key);
+        // more digits or a ',' never make a display compact again
+        if(known && !((key >= '0' && key <= '9') || key == ',' || key == '.')) pack(t, id, calc);
+        return known;
+    }
+
+    Calc calc;
+    expand(t, id, &calc);
+    bool known = calc_press_key(&calc, key);
+    if(known) pack(t, id, &calc);
+    return known;
+}
+
+
+/* ---------------------------------------------------------------------------------------------------------------- */
+/* Keys on the columns, each the counterpart of its calc_press_*()                                                   */
+/* ---------------------------------------------------------------------------------------------------------------- */
+
+/* False where the Calc has to do it. */
+static bool press_digit(Sessions *t, uint32_t id, char digit) {
+    uint16_t state = t->state[id];
+    uint64_t magnitude = t->shown[id];
+
+    if(state & SESSION_ENTERING) {
+        state = with_number(state, false, SESSION_NO_COMMA);
+        magnitude = 0;
+    } else if(kind_of(state) != SESSION_NUMBER) {
+        return false;
+    }
+
+    unsigned scale = scale_of(state);
+    if(magnitude == 0 && scale == SESSION_NO_COMMA) {
+        if(state & SESSION_NEGATIVE) return false;
+        magnitude = (uint64_t)(digit - '0');
+    } else {
+        if(magnitude > (UINT64_MAX - 9) / 10 || scale == SESSIONS_MAX_SCALE) return false;
+        magnitude = magnitude * 10 + (uint64_t)(digit - '0');
+        if(scale != SESSION_NO_COMMA) scale++;
+    }
+    state = with_number(state, (state & SESSION_NEGATIVE) != 0, scale);
+    t->shown[id] = magnitude;
+    t->state[id] = state & (uint16_t)~(SESSION_ENTERING | SESSION_AFTER_EQ);
+    return true;
+}
+
+
+static bool press_comma(Sessions *t, uint32_t id) {
+    uint16_t state = t->state[id];
+
+    if(state & SESSION_ENTERING) {
+        state = with_number(state, false, 0);
+        t->shown[id] = 0;
+    } else if(kind_of(state) != SESSION_NUMBER) {
+        return false;
+    } else if(scale_of(state) == SESSION_NO_COMMA) {
+        state = with_number(state, (state & SESSION_NEGATIVE) != 0, 0);
+    }
+    t->state[id] = state & (uint16_t)~(SESSION_ENTERING | SESSION_AFTER_EQ);
+    return true;
+}
+
+
+static void press_op(Sessions *t, uint32_t id, char op) {
+    uint16_t state = t->state[id];
+    unsigned pending = state & SESSION_PENDING;
+    int64_t curInt, accInt, resInt;
+    bool curExact;
+    double cur = operand(t, id, &curInt, &curExact);
+
+    if(pending && !(state & SESSION_ENTERING)) {
+        double acc = acc_of(t, id, &accInt);
+        if((state & SESSION_ACC_EXACT) && curExact && eval_int(accInt, curInt, pendingOps[pending], &resInt)) {
+            store_whole(t, id, resInt);
+        } else {
+            double res = eval(acc, cur, pendingOps[pending]);
+            if(isnan(res)) {
+                store_error(t, id);
+                t->state[id] = (uint16_t)((t->state[id] & ~SESSION_PENDING) | SESSION_ENTERING);
+                return;
+            }
+            store_double(t, id, res);
+        }
+    } else if(!pending) {
+        set_acc(t, id, cur, curExact ? curInt : 0, curExact);
+    }
+    state = t->state[id] & (uint16_t)~(SESSION_PENDING | SESSION_AFTER_EQ);
+    t->state[id] = (uint16_t)(state | pending_index(op) | SESSION_ENTERING);
+}
+
+
+static void press_eq(Sessions *t, uint32_t id) {
+    uint16_t state = t->state[id];
+    unsigned pending = state & SESSION_PENDING;
+    if(!pending) return;
+
+    int64_t rightInt, accInt, resultInt;
+    bool rightExact;
+    double right = operand(t, id, &rightInt, &rightExact);
+    double acc = acc_of(t, id, &accInt);
+
+    if((state & SESSION_ACC_EXACT) && rightExact && eval_int(accInt, rightInt, pendingOps[pending], &resultInt)) {
+        store_whole(t, id, resultInt);
+    } else {
+        double result = eval(acc, right, pendingOps[pending]);
+        if(isnan(result)) store_error(t, id);
+        else              store_double(t, id, result);
+    }
+    state = t->state[id] & (uint16_t)~SESSION_PENDING;
+    t->state[id] = state | SESSION_ENTERING | SESSION_AFTER_EQ;
+}
+
+
+static bool press_sign(Sessions *t, uint32_t id) {
+    uint16_t state = t->state[id];
+    if(kind_of(state) != SESSION_NUMBER) return false;
+
+    bool negative = (state & SESSION_NEGATIVE) != 0;
+    unsigned scale = scale_of(state);
+    // "0" and "0,0" keep their sign, and the flags
+    if(!negative && t->shown[id] == 0 && (scale == SESSION_NO_COMMA || scale == 1)) return true;
+
+    state = with_number(state, !negative, scale);
+    t->state[id] = (uint16_t)((state | SESSION_ENTERING) & ~SESSION_AFTER_EQ);
+    return true;
+}
+
+
+static void press_pct(Sessions *t, uint32_t id) {
+    int64_t whole;
+    bool exact;
+    double value = operand(t, id, &whole, &exact) / 100.0;
+
+    t->shown[id] = double_to_bits(value);
+    t->state[id] = with_kind(with_number(t->state[id], false, 0), SESSION_DOUBLE) | SESSION_ENTERING | SESSION_AFTER_EQ;
+}
+
+
+static bool press_backspace(Sessions *t, uint32_t id) {
+    uint16_t state = t->state[id];
+    uint64_t magnitude = t->shown[id];
+    bool negative = (state & SESSION_NEGATIVE) != 0;
+    unsigned scale = scale_of(state);
+
+    if(kind_of(state) == SESSION_ERROR || (kind_of(state) == SESSION_NUMBER && !negative && magnitude == 0
+                                           && scale == SESSION_NO_COMMA)) {
+        reset(t, id);
+        return true;
+    }
+    if(kind_of(state) != SESSION_NUMBER) return false;
+
+    if(scale == SESSION_NO_COMMA && magnitude < 10) {
+        // the last digit, maybe after a '-': "0", and lastWasEq stays
+        t->shown[id] = 0;
+        t->state[id] = with_number(state, false, SESSION_NO_COMMA) | SESSION_ENTERING;
+        return true;
+    }
+    if(scale == 0) {
+        scale = SESSION_NO_COMMA;
+    } else {
+        magnitude /= 10;
+        if(scale != SESSION_NO_COMMA) scale--;
+    }
+    state = with_number(state, negative, scale);
+    t->shown[id] = magnitude;
+    t->state[id] = (uint16_t)((state | SESSION_ENTERING) & ~SESSION_AFTER_EQ);
+    return true;
+}
+
+
+/* ---------------------------------------------------------------------------------------------------------------- */
+/* Table                                                                                                             */
+/* ---------------------------------------------------------------------------------------------------------------- */
+
+void sessions_init(Sessions *t) {
+    memset(t, 0, sizeof(*t));
+}
+
+
+void sessions_free(Sessions *t) {
+    free(t->acc);
+    free(t->shown);
+    free(t->state);
+    free(t->freeIds);
+    free(t->spill);
+    free(t->spillFree);
+    memset(t, 0, sizeof(*t));
+}
+
+
+static bool grow(Sessions *t) {
+    uint32_t cap = t->cap ? t->cap * 2 : SESSIONS_INITIAL;
+    if(cap <= t->cap) return false;
+
+    uint64_t *acc = realloc(t->acc, (size_t)cap * sizeof(uint64_t));
+    if(!acc) return false;
+    t->acc = acc;
+    uint64_t *shown = realloc(t->shown, (size_t)cap * sizeof(uint64_t));
+    if(!shown) return false;
+    t->shown = shown;
+    uint16_t *state = realloc(t->state, (size_t)cap * sizeof(uint16_t));
+    if(!state) return false;
+    t->state = state;
+
+    t->cap = cap;
+    return true;
+}
+
+
+/* A new session showing "0", like a Calc after calc_init(); -1 without memory. */
+int64_t sessions_open(Sessions *t) {
+    uint32_t id;
+    if(t->freeCount) {
+        id = t->freeIds[--t->freeCount];
+    } else {
+        if(t->count == t->cap && !grow(t)) return -1;
+        id = t->count++;
+    }
+    reset(t, id);
+    return id;
+}
+
+
+void sessions_close(Sessions *t, uint32_t id) {
+    if(id >= t->count) return;
+    if(kind_of(t->state[id]) == SESSION_SPILLED) spill_release(t, (uint32_t)t->shown[id]);
+    reset(t, id);
+
+    if(t->freeCount == t->freeCap) {
+        uint32_t cap = t->freeCap ? t->freeCap * 2 : 256;
+        uint32_t *freeIds = realloc(t->freeIds, (size_t)cap * sizeof(uint32_t));
+        if(!freeIds) return;
+        t->freeIds = freeIds;
+        t->freeCap = cap;
+    }
+    t->freeIds[t->freeCount++] = id;
+}
+
+
+/* calc_press_key() for one session; false for an unknown key or session. */
+bool sessions_press(Sessions *t, uint32_t id, char key) {
+    if(id >= t->count) return false;
+    if(kind_of(t->state[id]) == SESSION_SPILLED) return press_calc(t, id, key);
+
+    switch (key) {
+        case '0': case '1': case '2': case '3': case '4':
+        case '5': case '6': case '7': case '8': case '9':
+            return press_digit(t, id, key) || press_calc(t, id, key);
+        case ',': case '.':
+            return press_comma(t, id) || press_calc(t, id, key);
+        case '+': case '-': case '*': case '/':
+            press_op(t, id, key);
+            return true;
+        case 'x': case 'X':
+            press_op(t, id, '*');
+            return true;
+        case CALC_KEY_EQ:
+            press_eq(t, id);
+            return true;
+        case CALC_KEY_AC: case 'c':
+            reset(t, id);
+            return true;
+        case CALC_KEY_SIGN:
+            return press_sign(t, id) || press_calc(t, id, key);
+        case CALC_KEY_PCT:
+            press_pct(t, id);
+            return true;
+        case CALC_KEY_BACKSPACE:
+            return press_backspace(t, id) || press_calc(t, id, key);
+        default:
+            return false;
+    }
+}
+
+
+/* Applies a batch of keys in order. Returns how many were known keys of known sessions. */
+size_t sessions_apply(Sessions *t, const SessionEvent *events, size_t count) {
+    size_t applied = 0;
+    for(size_t i = 0; i < count; i++) {
+        if(i + SESSIONS_PREFETCH < count) {
+            uint32_t ahead = events[i + SESSIONS_PREFETCH].session;
+            if(ahead < t->count) {
+                __builtin_prefetch(&t->state[ahead], 1);
+                __builtin_prefetch(&t->acc[ahead], 1);
+                __builtin_prefetch(&t->shown[ahead], 1);
+            }
+        }
+        applied += sessions_press(t, events[i].session, events[i].key);
+    }
+    return applied;
+}
+
+
+/* What the display of the session shows, like Calc.display; empty for an unknown session. */
+size_t sessions_display(const Sessions *t, uint32_t id, char *out, size_t cap) {
+    if(cap == 0) return 0;
+    if(id >= t->count) {
+        out[0] = '\0';
+        return 0;
+    }
+
+    char text[SESSIONS_TEXT];
+    size_t len = display_text(t, id, text);
+    if(len + 1 > cap) len = cap - 1;
+    memcpy(out, text, len);
+    out[len] = '\0';
+    return len;
+}
+
+
+/* The session as a Calc on the double backend, e.g. to hand it to an engine; false for an unknown session. */
+bool sessions_get(const Sessions *t, uint32_t id, Calc *calc) {
+    if(id >= t->count) return false;
+    if(kind_of(t->state[id]) == SESSION_SPILLED) {
+        *calc = t->spill[t->shown[id]];
+        return true;
+    }
+    expand(t, id, calc);
+    return true;
+}
+
+
+size_t sessions_memory(const Sessions *t) {
+    return (size_t)t->cap * (2 * sizeof(uint64_t) + sizeof(uint16_t)) + (size_t)t->freeCap * sizeof(uint32_t)
+           + (size_t)t->spillCap * (sizeof(Calc) + sizeof(uint32_t));
+}
@@ -0,0 +1,90 @@
+/***********************************************************************************************************************
+ * @author Christian Reiswich
+ * @date 18 Oct. 2026
+ * @version 1.0
+ * @brief Raylib Calculator
+ * @details Table of calculator sessions, for hosting one per user. A Calc is 272 bytes, most of them display text
+ *          and decimal scratch; here a session is three columns, 18 bytes in all:
+ *
+ *            acc    the accumulator, as int64_t while it is a whole number, else the bits of a double
+ *            shown  what the display shows, by kind: a typed number as magnitude (sign and digits after ','
+ *                   are in the state), the double of a result, or the slot of a spilled Calc
+ *            state  pending operator, kind, the enteringNew/lastWasEq/accExact flags, sign and comma scale
+ *
+ *          The display text is only made in sessions_display(). Digits, ',', the operators, '=', AC, +/- and
+ *          backspace on a typed number run on the columns; everything else, and any state whose text has no
+ *          compact form (a display the backspace key cut out of a result, say), goes through a real Calc and is
+ *          packed again afterwards. A session whose text still cannot be packed stays "spilled" as a Calc of
+ *          its own until it can. Either way a session behaves exactly like a Calc on the double backend, which
+ *          calc_bench --check verifies on random keystrokes.
+ *
+ *          sessions_apply() takes a batch of (session, key) events in any mix of sessions and prefetches the
+ *          columns of the events SESSIONS_PREFETCH ahead, so the cache misses of a batch overlap instead of
+ *          queueing up. With four million sessions (75 MB) that halves the time per event; sorting the batch by
+ *          session first cost more than it saved.
+ **********************************************************************************************************************/
+
+#ifndef RAYLIBPROJEKT_SESSIONS_H
+#define RAYLIBPROJEKT_SESSIONS_H
+
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "calc.h"
+
+#define SESSIONS_PREFETCH   16          // events looked ahead in sessions_apply()
+#define SESSIONS_MAX_SCALE  40          // digits after ',' a typed number may have and stay compact
+
+#define SESSION_PENDING     0x0007u     // 0, or 1 to 4 for '+', '-', '*', '/'
+#define SESSION_KIND        0x0018u
+#define SESSION_KIND_SHIFT  3
+#define SESSION_ENTERING    0x0020u
+#define SESSION_AFTER_EQ    0x0040u
+#define SESSION_ACC_EXACT   0x0080u
+#define SESSION_NEGATIVE    0x0100u     // the typed number has a '-'
+#define SESSION_SCALE_SHIFT 9           // digits after ',' in the upper 7 bits
+#define SESSION_NO_COMMA    127
+
+typedef enum {
+    SESSION_NUMBER,                     // a number as typed: sign, digits, maybe a ','
+    SESSION_DOUBLE,                     // the text of numfmt for a double result
+    SESSION_ERROR,
+    SESSION_SPILLED                     // a full Calc in the spill array
+} SessionKind;
+
+typedef struct {
+    uint32_t session;
+    char     key;
+} SessionEvent;
+
+typedef struct {
+    uint64_t     *acc;
+    uint64_t     *shown;
+    uint16_t     *state;
+    uint32_t      count;                // ids below count have been handed out
+    uint32_t      cap;
+
+    uint32_t     *freeIds;              // closed sessions, reused first
+    uint32_t      freeCount;
+    uint32_t      freeCap;
+
+    Calc         *spill;
+    uint32_t     *spillFree;
+    uint32_t      spillCount;           // slots in use or on the free list
+    uint32_t      spillFreeCount;
+    uint32_t      spillCap;
+} Sessions;
+
+void    sessions_init   (Sessions *t);
+void    sessions_free   (Sessions *t);
+int64_t sessions_open   (Sessions *t);
+void    sessions_close  (Sessions *t, uint32_t id);
+bool    sessions_press  (Sessions *t, uint32_t id, char key);
+size_t  sessions_apply  (Sessions *t, const SessionEvent *events, size_t count);
+size_t  sessions_display(const Sessions *t, uint32_t id, char *out, size_t cap);
+bool    sessions_get    (const Sessions *t, uint32_t id, Calc *calc);
+size_t  sessions_memory (const Sessions *t);
+
+
+#endif //RAYLIBPROJEKT_SESSIONS_H
@@ -0,0 +1,325 @@
+/***********************************************************************************************************************
+ * @author Christian Reiswich
+ * @date 18 Oct. 2026
+ * @version 1.0
+ * @brief Raylib Calculator
+ * @details
+ **********************************************************************************************************************/
+
+#include "sheet.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+static bool valid_name(const char *name) {
+    size_t i = 0;
+    for(; name[i]; i++) {
+        char c = name[i];
+        bool alpha = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+        bool digit = (c >= '0' && c <= '9');
+        if(!alpha && !(digit && i > 0)) return false;
+    }
+    return i > 0 && i < EXPR_NAME_LEN;
+}
+
+
+static uint32_t hash_name(const char *name) {
+    uint32_t h = 2166136261u;
+    for(; *name; name++) h = (h ^ (uint8_t)*name) * 16777619u;
+    return h;
+}
+
+
+static int *slot_of(const Sheet *sheet, const char *name) {
+    uint32_t mask = (uint32_t)sheet->slotCap - 1;
+    for(uint32_t i = hash_name(name) & mask;; i = (i + 1) & mask) {
+        int *slot = &sheet->slots[i];
+        if(*slot == 0 || strcmp(sheet->cells[*slot - 1].name, name) == 0) return slot;
+    }
+}
+
+
+static bool grow_slots(Sheet *sheet) {
+    int cap = sheet->slotCap ? sheet->slotCap * 2 : 256;
+    int *slots = calloc((size_t)cap, sizeof(int));
+    if(!slots) return false;
+
+    free(sheet->slots);
+    sheet->slots   = slots;
+    sheet->slotCap = cap;
+    for(int i = 0; i < sheet->count; i++) *slot_of(sheet, sheet->cells[i].name) = i + 1;
+    return true;
+}
+
+
+static bool grow_cells(Sheet *sheet) {
+    int cap = sheet->cap ? sheet->cap * 2 : 64;
+    SheetCell *cells = realloc(sheet->cells, (size_t)cap * sizeof(SheetCell));
+    if(!cells) return false;
+    sheet->cells = cells;
+
+    int *dirty = realloc(sheet->dirty, (size_t)cap * sizeof(int));
+    if(!dirty) return false;
+    sheet->dirty = dirty;
+
+    int *work = realloc(sheet->work, (size_t)cap * sizeof(int));
+    if(!work) return false;
+    sheet->work = work;
+
+    sheet->cap = cap;
+    return true;
+}
+
+
+/* Index of the cell called `name`, created empty if there is none yet; -1 without memory. */
+static int intern(Sheet *sheet, const char *name) {
+    if(sheet->slotCap == 0 && !grow_slots(sheet)) return -1;
+
+    int *slot = slot_of(sheet, name);
+    if(*slot) return *slot - 1;
+
+    if(sheet->count == sheet->cap && !grow_cells(sheet)) return -1;
+    if((sheet->count + 1) * 2 > sheet->slotCap) {
+        if(!grow_slots(sheet)) return -1;
+        slot = slot_of(sheet, name);
+    }
+
+    int index = sheet->count++;
+    SheetCell *cell = &sheet->cells[index];
+    memset(cell, 0, sizeof(*cell));
+    strcpy(cell->name, name);
+    cell->value = NAN;
+    *slot = index + 1;
+    return index;
+}
+
+
+static bool reserve_user(SheetCell *cell) {
+    if(cell->userCount < cell->userCap) return true;
+
+    int cap = cell->userCap ? cell->userCap * 2 : 4;
+    int *users = realloc(cell->users, (size_t)cap * sizeof(int));
+    if(!users) return false;
+    cell->users   = users;
+    cell->userCap = cap;
+    return true;
+}
+
+
+static void detach(Sheet *sheet, int index) {
+    const SheetCell *cell = &sheet->cells[index];
+    for(int i = 0; i < cell->prog->varCount; i++) {
+        SheetCell *arg = &sheet->cells[cell->args[i]];
+        for(int k = 0; k < arg->userCount; k++) {
+            if(arg->users[k] == index) {
+                arg->users[k] = arg->users[--arg->userCount];
+                break;
+            }
+        }
+    }
+}
+
+
+/* Whether one of `args` is `from` or depends on it, i.e. whether reading them from `from` closes a cycle. */
+static bool reaches(Sheet *sheet, int from, const int *args, int argCount) {
+    uint32_t gen = ++sheet->generation;
+    int top = 0;
+    sheet->work[top++] = from;
+    sheet->cells[from].mark = gen;
+
+    while(top > 0) {
+        int index = sheet->work[--top];
+        for(int i = 0; i < argCount; i++) {
+            if(args[i] == index) return true;
+        }
+        const SheetCell *cell = &sheet->cells[index];
+        for(int k = 0; k < cell->userCount; k++) {
+            SheetCell *user = &sheet->cells[cell->users[k]];
+            if(user->mark == gen) continue;
+            user->mark = gen;
+            sheet->work[top++] = cell->users[k];
+        }
+    }
+    return false;
+}
+
+
+static void mark_dirty(Sheet *sheet, int index) {
+    sheet->cells[index].edited = true;
+    if(sheet->cells[index].dirty) return;
+
+    int top = 0;
+    sheet->cells[index].dirty = true;
+    sheet->dirty[sheet->dirtyCount++] = index;
+    sheet->work[top++] = index;
+
+    while(top > 0) {
+        const SheetCell *cell = &sheet->cells[sheet->work[--top]];
+        for(int k = 0; k < cell->userCount; k++) {
+            int user = cell->users[k];
+            if(sheet->cells[user].dirty) continue;
+            sheet->cells[user].dirty = true;
+            sheet->dirty[sheet->dirtyCount++] = user;
+            sheet->work[top++] = user;
+        }
+    }
+}
+
+
+void sheet_init(Sheet *sheet) {
+    memset(sheet, 0, sizeof(*sheet));
+}
+
+
+void sheet_free(Sheet *sheet) {
+    for(int i = 0; i < sheet->count; i++) {
+        free(sheet->cells[i].prog);
+        free(sheet->cells[i].users);
+    }
+    free(sheet->cells);
+    free(sheet->slots);
+    free(sheet->dirty);
+    free(sheet->work);
+    memset(sheet, 0, sizeof(*sheet));
+}
+
+
+int sheet_find(const Sheet *sheet, const char *name) {
+    if(sheet->slotCap == 0) return -1;
+    return *slot_of(sheet, name) - 1;
+}
+
+
+SheetStatus sheet_set_value(Sheet *sheet, const char *name, double value) {
+    if(!valid_name(name)) return SHEET_BAD_NAME;
+
+    int index = intern(sheet, name);
+    if(index < 0) return SHEET_NO_MEMORY;
+
+    SheetCell *cell = &sheet->cells[index];
+    if(!cell->prog && cell->defined && memcmp(&cell->value, &value, sizeof(value)) == 0) return SHEET_OK;
+
+    if(cell->prog) {
+        detach(sheet, index);
+        free(cell->prog);
+        cell->prog = NULL;
+    }
+    cell->value   = value;
+    cell->defined = true;
+    mark_dirty(sheet, index);
+    return SHEET_OK;
+}
+
+
+SheetStatus sheet_set(Sheet *sheet, const char *name, const char *src) {
+    if(!valid_name(name)) return SHEET_BAD_NAME;
+
+    ExprProgram prog;
+    if(!expr_compile(&prog, src)) return SHEET_SYNTAX;
+    if(prog.varCount == 0) return sheet_set_value(sheet, name, expr_run(&prog, NULL));
+
+    // interning may move the cells, so only indices are kept until the graph is checked
+    int index = intern(sheet, name);
+    if(index < 0) return SHEET_NO_MEMORY;
+
+    int args[EXPR_MAX_VARS];
+    for(int i = 0; i < prog.varCount; i++) {
+        args[i] = intern(sheet, prog.vars[i]);
+        if(args[i] < 0) return SHEET_NO_MEMORY;
+    }
+    if(reaches(sheet, index, args, prog.varCount)) return SHEET_CYCLE;
+
+    for(int i = 0; i < prog.varCount; i++) {
+        if(!reserve_user(&sheet->cells[args[i]])) return SHEET_NO_MEMORY;
+    }
+
+    SheetCell *cell = &sheet->cells[index];
+    if(cell->prog) {
+        detach(sheet, index);
+    } else if((cell->prog = malloc(sizeof(ExprProgram))) == NULL) {
+        return SHEET_NO_MEMORY;
+    }
+    *cell->prog = prog;
+    memcpy(cell->args, args, sizeof(int) * (size_t)prog.varCount);
+    cell->defined = true;
+
+    for(int i = 0; i < prog.varCount; i++) {
+        SheetCell *arg = &sheet->cells[args[i]];
+        arg->users[arg->userCount++] = index;
+    }
+    mark_dirty(sheet, index);
+    return SHEET_OK;
+}
+
+
+/* Kahn's algorithm restricted to the dirty cells: a cell is queued once all of its dirty inputs are done.
+ * Returns the number of formulas evaluated. */
+int sheet_recalc(Sheet *sheet) {
+    SheetCell *cells = sheet->cells;
+    int head = 0, tail = 0;
+
+    for(int i = 0; i < sheet->dirtyCount; i++) {
+        SheetCell *cell = &cells[sheet->dirty[i]];
+        cell->pending = 0;
+        if(cell->prog) {
+            for(int a = 0; a < cell->prog->varCount; a++) cell->pending += cells[cell->args[a]].dirty;
+        }
+        if(cell->pending == 0) sheet->work[tail++] = sheet->dirty[i];
+    }
+
+    int evaluated = 0;
+    while(head < tail) {
+        SheetCell *cell = &cells[sheet->work[head++]];
+
+        if(cell->prog) {
+            bool stale = cell->edited;
+            for(int a = 0; a < cell->prog->varCount && !stale; a++) stale = cells[cell->args[a]].changed;
+
+            cell->changed = false;
+            if(stale) {
+                double vars[EXPR_MAX_VARS];
+                for(int a = 0; a < cell->prog->varCount; a++) vars[a] = cells[cell->args[a]].value;
+                double value = expr_run(cell->prog, vars);
+                cell->changed = memcmp(&value, &cell->value, sizeof(value)) != 0;
+                cell->value   = value;
+                evaluated++;
+            }
+        } else {
+            cell->changed = cell->edited;
+        }
+
+        for(int k = 0; k < cell->userCount; k++) {
+            if(--cells[cell->users[k]].pending == 0) sheet->work[tail++] = cell->users[k];
+        }
+    }
+
+    for(int i = 0; i < sheet->dirtyCount; i++) {
+        SheetCell *cell = &cells[sheet->dirty[i]];
+        cell->dirty   = false;
+        cell->edited  = false;
+        cell->changed = false;
+    }
+    sheet->dirtyCount = 0;
+    sheet->evaluated += (unsigned long long)evaluated;
+    return evaluated;
+}
+
+
+double sheet_get(const Sheet *sheet, const char *name) {
+    int index = sheet_find(sheet, name);
+    return (index < 0) ? NAN : sheet->cells[index].value;
+}
+
+
+const char *sheet_status_text(SheetStatus status) {
+    switch (status) {
+        case SHEET_OK:        return "ok";
+        case SHEET_BAD_NAME:  return "invalid name";
+        case SHEET_SYNTAX:    return "syntax error";
+        case SHEET_CYCLE:     return "circular reference";
+        case SHEET_NO_MEMORY: return "out of memory";
+        default:              return "unknown";
+    }
+}
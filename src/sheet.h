@@ -0,0 +1,70 @@
+/***********************************************************************************************************************
+ * @author Christian Reiswich
+ * @date 18 Oct. 2026
+ * @version 1.0
+ * @brief Raylib Calculator
+ * @details Named cells in a dependency graph, e.g. "rate", "net" and "gross = net * (1 + rate)". Every cell holds a
+ *          plain value or a compiled formula over other cells. An edit marks the cell and everything downstream
+ *          dirty; sheet_recalc() then evaluates only the dirty cells, each after its inputs (Kahn's algorithm on
+ *          the dirty part of the graph), and skips cells whose inputs came out unchanged.
+ *
+ *          A formula that would close a cycle is rejected and the cell keeps its old content. Names that are
+ *          used before they are defined become empty cells whose value is NaN ("Error").
+ **********************************************************************************************************************/
+
+#ifndef RAYLIBPROJEKT_SHEET_H
+#define RAYLIBPROJEKT_SHEET_H
+
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+#include "expr.h"
+
+typedef enum {
+    SHEET_OK,
+    SHEET_BAD_NAME,
+    SHEET_SYNTAX,
+    SHEET_CYCLE,
+    SHEET_NO_MEMORY
+} SheetStatus;
+
+typedef struct {
+    char         name[EXPR_NAME_LEN];
+    double       value;
+    ExprProgram *prog;                  // NULL for a plain value
+    int          args[EXPR_MAX_VARS];   // cell of each formula variable
+    int         *users;                 // cells whose formula reads this one
+    int          userCount;
+    int          userCap;
+    int          pending;               // dirty inputs not yet evaluated, only during sheet_recalc()
+    uint32_t     mark;                  // search generation
+    bool         defined;
+    bool         dirty;                 // invariant: all users of a dirty cell are dirty
+    bool         edited;                // own content changed since the last recalc
+    bool         changed;               // value changed in the running recalc
+} SheetCell;
+
+typedef struct {
+    SheetCell *cells;
+    int        count;
+    int        cap;
+    int       *slots;                   // name hash, cell index + 1, 0 for free
+    int        slotCap;
+    int       *dirty;                   // dirty cells in marking order
+    int        dirtyCount;
+    int       *work;                    // stack and queue, one entry per cell
+    uint32_t   generation;
+    unsigned long long evaluated;       // formulas evaluated by sheet_recalc() in total
+} Sheet;
+
+void        sheet_init       (Sheet *sheet);
+void        sheet_free       (Sheet *sheet);
+int         sheet_find       (const Sheet *sheet, const char *name);
+SheetStatus sheet_set        (Sheet *sheet, const char *name, const char *src);
+SheetStatus sheet_set_value  (Sheet *sheet, const char *name, double value);
+int         sheet_recalc     (Sheet *sheet);
+double      sheet_get        (const Sheet *sheet, const char *name);
+const char *sheet_status_text(SheetStatus status);
+
+
+#endif //RAYLIBPROJEKT_SHEET_H
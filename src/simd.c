@@ -0,0 +1,511 @@
+/***********************************************************************************************************************
+ * @author Christian Reiswich
+ * @date 18 Oct. 2026
+ * @version 1.0
+ * @brief Raylib Calculator
+ * @details The vector kernels divide unconditionally and then blend NaN into the lanes whose divisor compares equal
+ *          to zero, which is the same test eval() does (so -0.0 counts as zero and a NaN divisor stays NaN).
+ *          Unknown op codes return the right operand, like eval().
+ **********************************************************************************************************************/
+
+#include "simd.h"
+#include "calc.h"
+
+#include <math.h>
+#include <pthread.h>
+#include <string.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define SIMD_X86 1
+#include <immintrin.h>
+#else
+#define SIMD_X86 0
+#endif
+
+
+static void batch_scalar(const double *l, const double *r, double *out, size_t n, char op) {
+    for(size_t i = 0; i < n; i++) out[i] = eval(l[i], r[i], op);
+}
+
+
+static void ops_scalar(const double *l, const double *r, const char *ops, double *out, size_t n) {
+    for(size_t i = 0; i < n; i++) out[i] = eval(l[i], r[i], ops[i]);
+}
+
+
+/* Knuth's two-sum: *sum + *comp gains v, the rounding error of the addition goes into *comp. */
+static inline void two_sum(double *sum, double *comp, double v) {
+    double t = *sum + v;
+    double z = t - *sum;
+    *comp += (*sum - (t - z)) + (v - z);
+    *sum = t;
+}
+
+
+static void sum_scalar(const double *x, size_t n, double *sum, double *comp) {
+    for(size_t i = 0; i < n; i++) two_sum(sum, comp, x[i]);
+}
+
+
+static double spread_scalar(const double *x, size_t n, double mean, double *min, double *max) {
+    double m2 = 0.0;
+    for(size_t i = 0; i < n; i++) {
+        double d = x[i] - mean;
+        m2 += d * d;
+        if(x[i] < *min) *min = x[i];
+        if(x[i] > *max) *max = x[i];
+    }
+    return m2;
+}
+
+
+/* Adds the per-lane sums and compensations of a vector kernel to the running sum. */
+static void fold_lanes(double *sum, double *comp, const double *lanes, const double *comps, int count) {
+    for(int k = 0; k < count; k++) {
+        two_sum(sum, comp, lanes[k]);
+        *comp += comps[k];
+    }
+}
+
+
+static double fold_spread(const double *m2, const double *mins, const double *maxs, int count, double *min, double *max) {
+    double total = 0.0;
+    for(int k = 0; k < count; k++) {
+        total += m2[k];
+        if(mins[k] < *min) *min = mins[k];
+        if(maxs[k] > *max) *max = maxs[k];
+    }
+    return total;
+}
+
+
+#if SIMD_X86
+
+__attribute__((target("sse2")))
+static void batch_sse2(const double *l, const double *r, double *out, size_t n, char op) {
+    const __m128d nan  = _mm_set1_pd(NAN);
+    const __m128d zero = _mm_setzero_pd();
+    size_t i = 0;
+
+    switch (op) {
+        case '+':
+            for(; i + 2 <= n; i += 2) _mm_storeu_pd(out + i, _mm_add_pd(_mm_loadu_pd(l + i), _mm_loadu_pd(r + i)));
+            break;
+        case '-':
+            for(; i + 2 <= n; i += 2) _mm_storeu_pd(out + i, _mm_sub_pd(_mm_loadu_pd(l + i), _mm_loadu_pd(r + i)));
+            break;
+        case '*':
+            for(; i + 2 <= n; i += 2) _mm_storeu_pd(out + i, _mm_mul_pd(_mm_loadu_pd(l + i), _mm_loadu_pd(r + i)));
+            break;
+        case '/':
+            for(; i + 2 <= n; i += 2) {
+                __m128d b = _mm_loadu_pd(r + i);
+                __m128d q = _mm_div_pd(_mm_loadu_pd(l + i), b);
+                __m128d z = _mm_cmpeq_pd(b, zero);
+                _mm_storeu_pd(out + i, _mm_or_pd(_mm_and_pd(z, nan), _mm_andnot_pd(z, q)));
+            }
+            break;
+        default:
+            memmove(out, r, n * sizeof(double));
+            return;
+    }
+    batch_scalar(l + i, r + i, out + i, n - i, op);
+}
+
+
+__attribute__((target("sse2")))
+static __m128d sse2_mask(const char *ops, char op) {
+    return _mm_castsi128_pd(_mm_set_epi64x(-(long long)(ops[1] == op), -(long long)(ops[0] == op)));
+}
+
+
+__attribute__((target("sse2")))
+static __m128d sse2_select(__m128d mask, __m128d yes, __m128d no) {
+    return _mm_or_pd(_mm_and_pd(mask, yes), _mm_andnot_pd(mask, no));
+}
+
+
+__attribute__((target("sse2")))
+static void ops_sse2(const double *l, const double *r, const char *ops, double *out, size_t n) {
+    const __m128d nan  = _mm_set1_pd(NAN);
+    const __m128d zero = _mm_setzero_pd();
+    size_t i = 0;
+
+    for(; i + 2 <= n; i += 2) {
+        __m128d a = _mm_loadu_pd(l + i);
+        __m128d b = _mm_loadu_pd(r + i);
+        __m128d q = sse2_select(_mm_cmpeq_pd(b, zero), nan, _mm_div_pd(a, b));
+
+        __m128d res = b;
+        res = sse2_select(sse2_mask(ops + i, '+'), _mm_add_pd(a, b), res);
+        res = sse2_select(sse2_mask(ops + i, '-'), _mm_sub_pd(a, b), res);
+        res = sse2_select(sse2_mask(ops + i, '*'), _mm_mul_pd(a, b), res);
+        res = sse2_select(sse2_mask(ops + i, '/'), q, res);
+        _mm_storeu_pd(out + i, res);
+    }
+    ops_scalar(l + i, r + i, ops + i, out + i, n - i);
+}
+
+
+__attribute__((target("avx2")))
+static void batch_avx2(const double *l, const double *r, double *out, size_t n, char op) {
+    const __m256d nan  = _mm256_set1_pd(NAN);
+    const __m256d zero = _mm256_setzero_pd();
+    size_t i = 0;
+
+    switch (op) {
+        case '+':
+            for(; i + 4 <= n; i += 4) _mm256_storeu_pd(out + i, _mm256_add_pd(_mm256_loadu_pd(l + i), _mm256_loadu_pd(r + i)));
+            break;
+        case '-':
+            for(; i + 4 <= n; i += 4) _mm256_storeu_pd(out + i, _mm256_sub_pd(_mm256_loadu_pd(l + i), _mm256_loadu_pd(r + i)));
+            break;
+        case '*':
+            for(; i + 4 <= n; i += 4) _mm256_storeu_pd(out + i, _mm256_mul_pd(_mm256_loadu_pd(l + i), _mm256_loadu_pd(r + i)));
+            break;
+        case '/':
+            for(; i + 4 <= n; i += 4) {
+                __m256d b = _mm256_loadu_pd(r + i);
+                __m256d q = _mm256_div_pd(_mm256_loadu_pd(l + i), b);
+                _mm256_storeu_pd(out + i, _mm256_blendv_pd(q, nan, _mm256_cmp_pd(b, zero, _CMP_EQ_OQ)));
+            }
+            break;
+        default:
+            memmove(out, r, n * sizeof(double));
+            return;
+    }
+    batch_scalar(l + i, r + i, out + i, n - i, op);
+}
+
+
+__attribute__((target("avx2")))
+static void ops_avx2(const double *l, const double *r, const char *ops, double *out, size_t n) {
+    const __m256d nan  = _mm256_set1_pd(NAN);
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256i add  = _mm256_set1_epi64x('+');
+    const __m256i sub  = _mm256_set1_epi64x('-');
+    const __m256i mul  = _mm256_set1_epi64x('*');
+    const __m256i div  = _mm256_set1_epi64x('/');
+    size_t i = 0;
+
+    for(; i + 4 <= n; i += 4) {
+        int raw;
+        memcpy(&raw, ops + i, sizeof(raw));
+        __m256i op = _mm256_cvtepu8_epi64(_mm_cvtsi32_si128(raw));
+
+        __m256d a = _mm256_loadu_pd(l + i);
+        __m256d b = _mm256_loadu_pd(r + i);
+        __m256d q = _mm256_blendv_pd(_mm256_div_pd(a, b), nan, _mm256_cmp_pd(b, zero, _CMP_EQ_OQ));
+
+        __m256d res = b;
+        res = _mm256_blendv_pd(res, _mm256_add_pd(a, b), _mm256_castsi256_pd(_mm256_cmpeq_epi64(op, add)));
+        res = _mm256_blendv_pd(res, _mm256_sub_pd(a, b), _mm256_castsi256_pd(_mm256_cmpeq_epi64(op, sub)));
+        res = _mm256_blendv_pd(res, _mm256_mul_pd(a, b), _mm256_castsi256_pd(_mm256_cmpeq_epi64(op, mul)));
+        res = _mm256_blendv_pd(res, q,                   _mm256_castsi256_pd(_mm256_cmpeq_epi64(op, div)));
+        _mm256_storeu_pd(out + i, res);
+    }
+    ops_scalar(l + i, r + i, ops + i, out + i, n - i);
+}
+
+
+__attribute__((target("avx512f")))
+static void batch_avx512(const double *l, const double *r, double *out, size_t n, char op) {
+    const __m512d nan  = _mm512_set1_pd(NAN);
+    const __m512d zero = _mm512_setzero_pd();
+    size_t i = 0;
+
+    switch (op) {
+        case '+':
+            for(; i + 8 <= n; i += 8) _mm512_storeu_pd(out + i, _mm512_add_pd(_mm512_loadu_pd(l + i), _mm512_loadu_pd(r + i)));
+            break;
+        case '-':
+            for(; i + 8 <= n; i += 8) _mm512_storeu_pd(out + i, _mm512_sub_pd(_mm512_loadu_pd(l + i), _mm512_loadu_pd(r + i)));
+            break;
+        case '*':
+            for(; i + 8 <= n; i += 8) _mm512_storeu_pd(out + i, _mm512_mul_pd(_mm512_loadu_pd(l + i), _mm512_loadu_pd(r + i)));
+            break;
+        case '/':
+            for(; i + 8 <= n; i += 8) {
+                __m512d b = _mm512_loadu_pd(r + i);
+                __m512d q = _mm512_div_pd(_mm512_loadu_pd(l + i), b);
+                _mm512_storeu_pd(out + i, _mm512_mask_blend_pd(_mm512_cmp_pd_mask(b, zero, _CMP_EQ_OQ), q, nan));
+            }
+            break;
+        default:
+            memmove(out, r, n * sizeof(double));
+            return;
+    }
+    batch_scalar(l + i, r + i, out + i, n - i, op);
+}
+
+
+__attribute__((target("avx512f")))
+static void ops_avx512(const double *l, const double *r, const char *ops, double *out, size_t n) {
+    const __m512d nan  = _mm512_set1_pd(NAN);
+    const __m512d zero = _mm512_setzero_pd();
+    const __m512i add  = _mm512_set1_epi64('+');
+    const __m512i sub  = _mm512_set1_epi64('-');
+    const __m512i mul  = _mm512_set1_epi64('*');
+    const __m512i div  = _mm512_set1_epi64('/');
+    size_t i = 0;
+
+    for(; i + 8 <= n; i += 8) {
+        __m512i op = _mm512_cvtepu8_epi64(_mm_loadl_epi64((const __m128i *)(const void *)(ops + i)));
+
+        __m512d a = _mm512_loadu_pd(l + i);
+        __m512d b = _mm512_loadu_pd(r + i);
+        __m512d q = _mm512_mask_blend_pd(_mm512_cmp_pd_mask(b, zero, _CMP_EQ_OQ), _mm512_div_pd(a, b), nan);
+
+        __m512d res = b;
+        res = _mm512_mask_blend_pd(_mm512_cmpeq_epi64_mask(op, add), res, _mm512_add_pd(a, b));
+        res = _mm512_mask_blend_pd(_mm512_cmpeq_epi64_mask(op, sub), res, _mm512_sub_pd(a, b));
+        res = _mm512_mask_blend_pd(_mm512_cmpeq_epi64_mask(op, mul), res, _mm512_mul_pd(a, b));
+        res = _mm512_mask_blend_pd(_mm512_cmpeq_epi64_mask(op, div), res, q);
+        _mm512_storeu_pd(out + i, res);
+    }
+    ops_scalar(l + i, r + i, ops + i, out + i, n - i);
+}
+
+
+__attribute__((target("sse2")))
+static void sum_sse2(const double *x, size_t n, double *sum, double *comp) {
+    __m128d s = _mm_setzero_pd();
+    __m128d c = _mm_setzero_pd();
+    size_t i = 0;
+
+    for(; i + 2 <= n; i += 2) {
+        __m128d v = _mm_loadu_pd(x + i);
+        __m128d t = _mm_add_pd(s, v);
+        __m128d z = _mm_sub_pd(t, s);
+        c = _mm_add_pd(c, _mm_add_pd(_mm_sub_pd(s, _mm_sub_pd(t, z)), _mm_sub_pd(v, z)));
+        s = t;
+    }
+    double lanes[2], comps[2];
+    _mm_storeu_pd(lanes, s);
+    _mm_storeu_pd(comps, c);
+    fold_lanes(sum, comp, lanes, comps, 2);
+    sum_scalar(x + i, n - i, sum, comp);
+}
+
+
+__attribute__((target("sse2")))
+static double spread_sse2(const double *x, size_t n, double mean, double *min, double *max) {
+    __m128d m   = _mm_set1_pd(mean);
+    __m128d acc = _mm_setzero_pd();
+    __m128d lo  = _mm_set1_pd(*min);
+    __m128d hi  = _mm_set1_pd(*max);
+    size_t i = 0;
+
+    for(; i + 2 <= n; i += 2) {
+        __m128d v = _mm_loadu_pd(x + i);
+        __m128d d = _mm_sub_pd(v, m);
+        acc = _mm_add_pd(acc, _mm_mul_pd(d, d));
+        lo  = _mm_min_pd(lo, v);
+        hi  = _mm_max_pd(hi, v);
+    }
+    double m2[2], mins[2], maxs[2];
+    _mm_storeu_pd(m2, acc);
+    _mm_storeu_pd(mins, lo);
+    _mm_storeu_pd(maxs, hi);
+    return fold_spread(m2, mins, maxs, 2, min, max) + spread_scalar(x + i, n - i, mean, min, max);
+}
+
+
+__attribute__((target("avx2")))
+static void sum_avx2(const double *x, size_t n, double *sum, double *comp) {
+    __m256d s = _mm256_setzero_pd();
+    __m256d c = _mm256_setzero_pd();
+    size_t i = 0;
+
+    for(; i + 4 <= n; i += 4) {
+        __m256d v = _mm256_loadu_pd(x + i);
+        __m256d t = _mm256_add_pd(s, v);
+        __m256d z = _mm256_sub_pd(t, s);
+        c = _mm256_add_pd(c, _mm256_add_pd(_mm256_sub_pd(s, _mm256_sub_pd(t, z)), _mm256_sub_pd(v, z)));
+        s = t;
+    }
+    double lanes[4], comps[4];
+    _mm256_storeu_pd(lanes, s);
+    _mm256_storeu_pd(comps, c);
+    fold_lanes(sum, comp, lanes, comps, 4);
+    sum_scalar(x + i, n - i, sum, comp);
+}
+
+
+__attribute__((target("avx2")))
+static double spread_avx2(const double *x, size_t n, double mean, double *min, double *max) {
+    __m256d m   = _mm256_set1_pd(mean);
+    __m256d acc = _mm256_setzero_pd();
+    __m256d lo  = _mm256_set1_pd(*min);
+    __m256d hi  = _mm256_set1_pd(*max);
+    size_t i = 0;
+
+    for(; i + 4 <= n; i += 4) {
+        __m256d v = _mm256_loadu_pd(x + i);
+        __m256d d = _mm256_sub_pd(v, m);
+        acc = _mm256_add_pd(acc, _mm256_mul_pd(d, d));
+        lo  = _mm256_min_pd(lo, v);
+        hi  = _mm256_max_pd(hi, v);
+    }
+    double m2[4], mins[4], maxs[4];
+    _mm256_storeu_pd(m2, acc);
+    _mm256_storeu_pd(mins, lo);
+    _mm256_storeu_pd(maxs, hi);
+    return fold_spread(m2, mins, maxs, 4, min, max) + spread_scalar(x + i, n - i, mean, min, max);
+}
+
+
+__attribute__((target("avx512f")))
+static void sum_avx512(const double *x, size_t n, double *sum, double *comp) {
+    __m512d s = _mm512_setzero_pd();
+    __m512d c = _mm512_setzero_pd();
+    size_t i = 0;
+
+    for(; i + 8 <= n; i += 8) {
+        __m512d v = _mm512_loadu_pd(x + i);
+        __m512d t = _mm512_add_pd(s, v);
+        __m512d z = _mm512_sub_pd(t, s);
+        c = _mm512_add_pd(c, _mm512_add_pd(_mm512_sub_pd(s, _mm512_sub_pd(t, z)), _mm512_sub_pd(v, z)));
+        s = t;
+    }
+    double lanes[8], comps[8];
+    _mm512_storeu_pd(lanes, s);
+    _mm512_storeu_pd(comps, c);
+    fold_lanes(sum, comp, lanes, comps, 8);
+    sum_scalar(x + i, n - i, sum, comp);
+}
+
+
+__attribute__((target("avx512f")))
+static double spread_avx512(const double *x, size_t n, double mean, double *min, double *max) {
+    __m512d m   = _mm512_set1_pd(mean);
+    __m512d acc = _mm512_setzero_pd();
+    __m512d lo  = _mm512_set1_pd(*min);
+    __m512d hi  = _mm512_set1_pd(*max);
+    size_t i = 0;
+
+    for(; i + 8 <= n; i += 8) {
+        __m512d v = _mm512_loadu_pd(x + i);
+        __m512d d = _mm512_sub_pd(v, m);
+        acc = _mm512_add_pd(acc, _mm512_mul_pd(d, d));
+        lo  = _mm512_min_pd(lo, v);
+        hi  = _mm512_max_pd(hi, v);
+    }
+    double m2[8], mins[8], maxs[8];
+    _mm512_storeu_pd(m2, acc);
+    _mm512_storeu_pd(mins, lo);
+    _mm512_storeu_pd(maxs, hi);
+    return fold_spread(m2, mins, maxs, 8, min, max) + spread_scalar(x + i, n - i, mean, min, max);
+}
+
+#endif
+
+
+typedef void (*BatchFn)(const double *, const double *, double *, size_t, char);
+typedef void (*OpsFn)  (const double *, const double *, const char *, double *, size_t);
+typedef void   (*SumFn)   (const double *, size_t, double *, double *);
+typedef double (*SpreadFn)(const double *, size_t, double, double *, double *);
+
+/* Set up once through pthread_once(); the kernels and the level are swapped with atomic stores, so callers on any
+ * thread see either the old or the new kernel, never a torn one. */
+static pthread_once_t dispatchOnce = PTHREAD_ONCE_INIT;
+static int            supported    = SIMD_SCALAR;
+static SimdLevel      current      = SIMD_SCALAR;
+static BatchFn        batchFn      = batch_scalar;
+static OpsFn          opsFn        = ops_scalar;
+static SumFn          sumFn        = sum_scalar;
+static SpreadFn       spreadFn     = spread_scalar;
+
+
+static SimdLevel detect(void) {
+#if SIMD_X86
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx512f")) return SIMD_AVX512;
+    if(__builtin_cpu_supports("avx2"))    return SIMD_AVX2;
+    if(__builtin_cpu_supports("sse2"))    return SIMD_SSE2;
+#endif
+    return SIMD_SCALAR;
+}
+
+
+static void use_kernels(BatchFn batch, OpsFn ops, SumFn sum, SpreadFn spread) {
+    __atomic_store_n(&batchFn,  batch,  __ATOMIC_RELEASE);
+    __atomic_store_n(&opsFn,    ops,    __ATOMIC_RELEASE);
+    __atomic_store_n(&sumFn,    sum,    __ATOMIC_RELEASE);
+    __atomic_store_n(&spreadFn, spread, __ATOMIC_RELEASE);
+}
+
+
+static SimdLevel apply_level(SimdLevel level) {
+    if((int)level > supported) level = (SimdLevel)supported;
+
+    switch (level) {
+#if SIMD_X86
+        case SIMD_AVX512: use_kernels(batch_avx512, ops_avx512, sum_avx512, spread_avx512); break;
+        case SIMD_AVX2:   use_kernels(batch_avx2,   ops_avx2,   sum_avx2,   spread_avx2);   break;
+        case SIMD_SSE2:   use_kernels(batch_sse2,   ops_sse2,   sum_sse2,   spread_sse2);   break;
+#endif
+        default:
+            use_kernels(batch_scalar, ops_scalar, sum_scalar, spread_scalar);
+            level = SIMD_SCALAR;
+            break;
+    }
+    __atomic_store_n(&current, level, __ATOMIC_RELEASE);
+    return level;
+}
+
+
+static void dispatch_init(void) {
+    supported = (int)detect();
+    apply_level(SIMD_AVX512);
+}
+
+
+SimdLevel simd_set_level(SimdLevel level) {
+    pthread_once(&dispatchOnce, dispatch_init);
+    return apply_level(level);
+}
+
+
+SimdLevel simd_level(void) {
+    pthread_once(&dispatchOnce, dispatch_init);
+    return __atomic_load_n(&current, __ATOMIC_ACQUIRE);
+}
+
+
+const char *simd_level_name(SimdLevel level) {
+    switch (level) {
+        case SIMD_SSE2:   return "sse2";
+        case SIMD_AVX2:   return "avx2";
+        case SIMD_AVX512: return "avx512";
+        default:          return "scalar";
+    }
+}
+
+
+void eval_batch(const double *left, const double *right, double *out, size_t count, char op) {
+    pthread_once(&dispatchOnce, dispatch_init);
+    BatchFn kernel = __atomic_load_n(&batchFn, __ATOMIC_ACQUIRE);
+    kernel(left, right, out, count, op);
+}
+
+
+void eval_batch_ops(const double *left, const double *right, const char *ops, double *out, size_t count) {
+    pthread_once(&dispatchOnce, dispatch_init);
+    OpsFn kernel = __atomic_load_n(&opsFn, __ATOMIC_ACQUIRE);
+    kernel(left, right, ops, out, count);
+}
+
+
+void sum_batch(const double *values, size_t count, double *sum, double *comp) {
+    pthread_once(&dispatchOnce, dispatch_init);
+    SumFn kernel = __atomic_load_n(&sumFn, __ATOMIC_ACQUIRE);
+    kernel(values, count, sum, comp);
+}
+
+
+double spread_batch(const double *values, size_t count, double mean, double *min, double *max) {
+    pthread_once(&dispatchOnce, dispatch_init);
+    SpreadFn kernel = __atomic_load_n(&spreadFn, __ATOMIC_ACQUIRE);
+    return kernel(values, count, mean, min, max);
+}
@@ -0,0 +1,40 @@
+/***********************************************************************************************************************
+ * @author Christian Reiswich
+ * @date 18 Oct. 2026
+ * @version 1.0
+ * @brief Raylib Calculator
+ * @details Batch versions of eval() over struct-of-arrays operands. The kernel (scalar, SSE2, AVX2 or AVX-512) is
+ *          picked once at runtime from the CPU features, under pthread_once() so any thread may make the first
+ *          call; every kernel gives bit-identical results to eval(), including NaN for division by zero.
+ *
+ *          sum_batch() adds a block to a compensated sum (sum + comp), with an error-free two-sum per lane, so the
+ *          result stays within a rounding or two of the exact total however many blocks go in. spread_batch()
+ *          returns the sum of squared deviations from `mean` and widens min/max. Their lanes add up in a different
+ *          order per kernel, so the last bit may differ between levels.
+ **********************************************************************************************************************/
+
+#ifndef RAYLIBPROJEKT_SIMD_H
+#define RAYLIBPROJEKT_SIMD_H
+
+#pragma once
+#include <stddef.h>
+
+typedef enum {
+    SIMD_SCALAR,
+    SIMD_SSE2,
+    SIMD_AVX2,
+    SIMD_AVX512
+} SimdLevel;
+
+SimdLevel   simd_level     (void);
+SimdLevel   simd_set_level (SimdLevel level);
+const char *simd_level_name(SimdLevel level);
+
+void eval_batch    (const double *left, const double *right, double *out, size_t count, char op);
+void eval_batch_ops(const double *left, const double *right, const char *ops, double *out, size_t count);
+
+void   sum_batch   (const double *values, size_t count, double *sum, double *comp);
+double spread_batch(const double *values, size_t count, double mean, double *min, double *max);
+
+
+#endif //RAYLIBPROJEKT_SIMD_H
@@ -0,0 +1,166 @@
+/***********************************************************************************************************************
+ * @author Christian Reiswich
+ * @date 18 Oct. 2026
+ * @version 1.0
+ * @brief Raylib Calculator
+ * @details
+ **********************************************************************************************************************/
+
+#include "stats.h"
+#include "simd.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SKETCH_SHIFT (52 - STATS_SKETCH_BITS)
+
+
+void stats_init(Stats *stats, bool percentiles) {
+    memset(stats, 0, sizeof(*stats));
+    stats->min    = INFINITY;
+    stats->max    = -INFINITY;
+    stats->sketch = percentiles;
+}
+
+
+void stats_free(Stats *stats) {
+    for(int sign = 0; sign < 2; sign++) {
+        for(int e = 0; e < STATS_EXPONENTS; e++) free(stats->pages[sign][e]);
+    }
+    stats_init(stats, stats->sketch);
+}
+
+
+static bool sketch_add(Stats *stats, const double *values, size_t count) {
+    const double origin = stats->origin;
+    for(size_t i = 0; i < count; i++) {
+        double distance = values[i] - origin;
+        uint64_t bits;
+        memcpy(&bits, &distance, sizeof(bits));
+        unsigned sign     = (unsigned)(bits >> 63);
+        unsigned exponent = (unsigned)(bits >> 52) & (STATS_EXPONENTS - 1);
+
+        uint64_t *page = stats->pages[sign][exponent];
+        if(!page) {
+            page = calloc(STATS_PAGE_LEN, sizeof(uint64_t));
+            if(!page) return false;
+            stats->pages[sign][exponent] = page;
+            stats->pageCount++;
+        }
+        page[(bits >> SKETCH_SHIFT) & (STATS_PAGE_LEN - 1)]++;
+    }
+    return true;
+}
+
+
+/* False only if the sketch ran out of memory; the other statistics include the values regardless. */
+bool stats_add(Stats *stats, const double *values, size_t count) {
+    bool ok = true;
+    for(size_t off = 0; off < count; off += STATS_CHUNK) {
+        const double *x = values + off;
+        size_t n = (count - off < STATS_CHUNK) ? count - off : STATS_CHUNK;
+
+        double sum = 0.0, comp = 0.0;
+        sum_batch(x, n, &sum, &comp);
+        double mean = (sum + comp) / (double)n;
+        double m2   = spread_batch(x, n, mean, &stats->min, &stats->max);
+        if(stats->count == 0 && isfinite(stats->min)) stats->origin = stats->min;
+
+        sum_batch(&sum, 1, &stats->sum, &stats->comp);
+        stats->comp += comp;
+
+        // Chan et al.: merge the chunk's mean and squared deviations into the running ones
+        uint64_t total = stats->count + n;
+        double delta = mean - stats->mean;
+        stats->mean += delta * ((double)n / (double)total);
+        stats->m2   += m2 + delta * delta * ((double)stats->count * (double)n / (double)total);
+        stats->count = total;
+
+        if(ok && stats->sketch) ok = sketch_add(stats, x, n);
+    }
+    return ok;
+}
+
+
+double stats_sum(const Stats *stats) {
+    return stats->sum + stats->comp;
+}
+
+
+/* The compensated total over the count, which is closer than the running mean Chan's update keeps. */
+double stats_mean(const Stats *stats) {
+    if(stats->count == 0) return NAN;
+    double sum = stats_sum(stats);
+    return isfinite(sum) ? sum / (double)stats->count : stats->mean;
+}
+
+
+/* Population variance, or with `sample` the unbiased one (n - 1). NaN without enough values. */
+double stats_variance(const Stats *stats, bool sample) {
+    uint64_t div = stats->count - (sample ? 1 : 0);
+    if(stats->count == 0 || div == 0) return NAN;
+    return stats->m2 / (double)div;
+}
+
+
+static double bucket_value(unsigned sign, unsigned exponent, unsigned slot) {
+    if(exponent == STATS_EXPONENTS - 1) return sign ? -INFINITY : INFINITY;
+
+    uint64_t bits = ((uint64_t)sign << 63) | ((uint64_t)exponent << 52) | ((uint64_t)slot << SKETCH_SHIFT)
+                    | (1ull << (SKETCH_SHIFT - 1));
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+
+/* The value at fraction p (0 to 1) of the sorted data, from the sketch. 0 and 1 give min and max exactly. */
+double stats_percentile(const Stats *stats, double p) {
+    if(!stats->sketch || stats->count == 0 || isnan(p)) return NAN;
+    if(p <= 0.0) return stats->min;
+    if(p >= 1.0) return stats->max;
+
+    uint64_t rank = (uint64_t)(p * (double)(stats->count - 1) + 0.5);
+    if(rank == 0)                return stats->min;
+    if(rank >= stats->count - 1) return stats->max;
+
+    uint64_t seen = 0;
+    double value = stats->max;
+    bool found = false;
+
+    // negative values from the largest magnitude down, then positive ones from the smallest up
+    for(int e = STATS_EXPONENTS - 1; e >= 0 && !found; e--) {
+        const uint64_t *page = stats->pages[1][e];
+        if(!page) continue;
+        for(int slot = STATS_PAGE_LEN - 1; slot >= 0; slot--) {
+            seen += page[slot];
+            if(seen > rank) {
+                value = stats->origin + bucket_value(1, (unsigned)e, (unsigned)slot);
+                found = true;
+                break;
+            }
+        }
+    }
+    for(int e = 0; e < STATS_EXPONENTS && !found; e++) {
+        const uint64_t *page = stats->pages[0][e];
+        if(!page) continue;
+        for(int slot = 0; slot < STATS_PAGE_LEN; slot++) {
+            seen += page[slot];
+            if(seen > rank) {
+                value = stats->origin + bucket_value(0, (unsigned)e, (unsigned)slot);
+                found = true;
+                break;
+            }
+        }
+    }
+
+    if(value < stats->min) value = stats->min;
+    if(value > stats->max) value = stats->max;
+    return value;
+}
+
+
+size_t stats_memory(const Stats *stats) {
+    return sizeof(*stats) + stats->pageCount * STATS_PAGE_LEN * sizeof(uint64_t);
+}
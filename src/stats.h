@@ -0,0 +1,63 @@
+/***********************************************************************************************************************
+ * @author Christian Reiswich
+ * @date 18 Oct. 2026
+ * @version 1.0
+ * @brief Raylib Calculator
+ * @details Streaming statistics over a column of values that arrives in blocks of any size: count, sum, mean,
+ *          variance, min/max and percentiles, in constant memory apart from the percentile sketch.
+ *
+ *          Every block is cut into chunks of STATS_CHUNK values that stay in cache for three passes: a compensated
+ *          SIMD sum (sum_batch), the squared deviations from the chunk mean (spread_batch), and the sketch. The
+ *          chunk's mean and deviations are merged into the running ones with Chan's update, so neither a large
+ *          offset nor billions of values cost accuracy.
+ *
+ *          The sketch counts the distance of every value from `origin`, the least value of the first chunk, per
+ *          bucket of its IEEE bits: sign, exponent and the top STATS_SKETCH_BITS mantissa bits. A bucket spans a
+ *          relative width of 2^-STATS_SKETCH_BITS, and a percentile is reported as the middle of its bucket, so it
+ *          is off by at most half that (0.4 %) of its distance from the origin; measuring from there keeps data
+ *          like 1e9 +- 1 as sharp as data around zero. Buckets are allocated per exponent on first use, which
+ *          keeps ordinary data at a few kilobytes. The sketch is the slowest of the three passes; without
+ *          percentiles it is left out and the rest runs at close to memory speed.
+ *
+ *          Values must not be NaN; callers skip what failed to parse.
+ **********************************************************************************************************************/
+
+#ifndef RAYLIBPROJEKT_STATS_H
+#define RAYLIBPROJEKT_STATS_H
+
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define STATS_CHUNK        4096
+#define STATS_SKETCH_BITS  7
+#define STATS_EXPONENTS    2048
+#define STATS_PAGE_LEN     (1 << STATS_SKETCH_BITS)
+
+typedef struct {
+    uint64_t count;
+    double   sum;                   // sum + comp is the compensated total
+    double   comp;
+    double   mean;
+    double   m2;                    // sum of squared deviations from mean
+    double   min;
+    double   max;
+
+    bool      sketch;               // percentiles wanted
+    double    origin;
+    uint64_t *pages[2][STATS_EXPONENTS];    // [negative][biased exponent], STATS_PAGE_LEN counts each
+    size_t    pageCount;
+} Stats;
+
+void   stats_init      (Stats *stats, bool percentiles);
+void   stats_free      (Stats *stats);
+bool   stats_add       (Stats *stats, const double *values, size_t count);
+double stats_sum       (const Stats *stats);
+double stats_mean      (const Stats *stats);
+double stats_variance  (const Stats *stats, bool sample);
+double stats_percentile(const Stats *stats, double p);
+size_t stats_memory    (const Stats *stats);
+
+
+#endif //RAYLIBPROJEKT_STATS_H
@@ -11,10 +11,10 @@
 
 #pragma once
 #include "raylib.h"
-#include "calc.h"
+#include "engine.h"
 
 
-void ui_draw_display(const Calc *calc, Rectangle area, int fontSize);
+void ui_draw_display(const EngineView *view, Rectangle area, int fontSize);
 
 
 typedef struct {